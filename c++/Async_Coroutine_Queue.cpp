@@ -0,0 +1,299 @@
+/*
+ * Coroutine-Awaitable Async Queue (C++20)
+ *
+ * Queue::pop() on an empty queue just prints "Queue is empty". A blocking queue
+ * would park the whole thread instead. AsyncQueue lets a coroutine write
+ *
+ *     int job = co_await q.pop();
+ *
+ * and suspends only that coroutine when the queue is empty. A later push() hands
+ * the item straight to the oldest waiting consumer and schedules its resumption
+ * on an Executor, so thousands of logical consumers share a handful of threads.
+ *
+ * Design Patterns Used:
+ * - Strategy Pattern: Executor decides where resumed coroutines run
+ *   (InlineExecutor resumes on the pushing thread, ThreadPoolExecutor on workers)
+ *
+ * Operations to support:
+ * - push(T x): Enqueues x or hands it directly to a suspended consumer
+ * - pop(): Awaitable that yields the front item, suspending while the queue is empty
+ * - tryPop(T& out): Non-suspending variant, false if empty
+ */
+
+#include <iostream>
+#include <coroutine>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <exception>
+
+using namespace std;
+
+// ----------- Executors (Strategy) ------------
+
+/**
+ * Abstract base class for anything that can run a resumed coroutine
+ */
+class Executor {
+public:
+    virtual void post(coroutine_handle<> handle) = 0;
+    virtual ~Executor() = default;
+};
+
+/**
+ * Resumes the coroutine immediately on the thread that called push()
+ */
+class InlineExecutor : public Executor {
+public:
+    void post(coroutine_handle<> handle) override {
+        handle.resume();
+    }
+};
+
+/**
+ * Fixed set of worker threads resuming coroutines in FIFO order
+ */
+class ThreadPoolExecutor : public Executor {
+private:
+    mutex lock;
+    condition_variable ready;
+    deque<coroutine_handle<>> runQueue;
+    vector<thread> workers;
+    bool stopping = false;
+
+    void workerLoop() {
+        while (true) {
+            coroutine_handle<> handle;
+            {
+                unique_lock<mutex> guard(lock);
+                ready.wait(guard, [this]() { return stopping || !runQueue.empty(); });
+                if (runQueue.empty()) return;   // stopping and drained
+                handle = runQueue.front();
+                runQueue.pop_front();
+            }
+            handle.resume();
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * @param threads Number of worker threads
+     */
+    explicit ThreadPoolExecutor(size_t threads) {
+        for (size_t i = 0; i < threads; i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    void post(coroutine_handle<> handle) override {
+        {
+            lock_guard<mutex> guard(lock);
+            runQueue.push_back(handle);
+        }
+        ready.notify_one();
+    }
+
+    // Finishes all posted work, then joins the workers
+    ~ThreadPoolExecutor() override {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& t : workers) t.join();
+    }
+};
+
+// ----------- Async Queue ------------
+template <typename T>
+class AsyncQueue {
+private:
+    struct PopAwaiter;
+
+    mutex lock;
+    deque<T> items;                  // Buffered items when nobody is waiting
+    deque<PopAwaiter*> waiters;      // Suspended consumers, oldest first
+    Executor& executor;
+
+    /**
+     * Awaitable returned by pop(). Lives in the suspended coroutine's frame,
+     * so the waiter list needs no allocation of its own.
+     */
+    struct PopAwaiter {
+        AsyncQueue& queue;
+        optional<T> result;
+        coroutine_handle<> handle;
+
+        explicit PopAwaiter(AsyncQueue& q) : queue(q) {}
+
+        // Fast path: take an item without suspending
+        bool await_ready() {
+            lock_guard<mutex> guard(queue.lock);
+            return queue.takeLocked(result);
+        }
+
+        // Re-check under the lock; returning false resumes immediately
+        bool await_suspend(coroutine_handle<> h) {
+            lock_guard<mutex> guard(queue.lock);
+            if (queue.takeLocked(result)) return false;
+            handle = h;
+            queue.waiters.push_back(this);
+            return true;
+        }
+
+        T await_resume() {
+            return std::move(*result);
+        }
+    };
+
+    bool takeLocked(optional<T>& out) {
+        if (items.empty()) return false;
+        out.emplace(std::move(items.front()));
+        items.pop_front();
+        return true;
+    }
+
+public:
+    /**
+     * Constructor
+     * @param exec Executor used to resume consumers woken by push()
+     */
+    explicit AsyncQueue(Executor& exec) : executor(exec) {}
+
+    AsyncQueue(const AsyncQueue&) = delete;
+    AsyncQueue& operator=(const AsyncQueue&) = delete;
+
+    /**
+     * Adds an element; if a consumer is suspended, the element goes straight
+     * into its frame and the consumer is posted to the executor
+     * @param data The value to enqueue
+     */
+    void push(T data) {
+        PopAwaiter* waiter = nullptr;
+        {
+            lock_guard<mutex> guard(lock);
+            if (waiters.empty()) {
+                items.push_back(std::move(data));
+                return;
+            }
+            waiter = waiters.front();
+            waiters.pop_front();
+            waiter->result.emplace(std::move(data));
+        }
+        // Resume outside the lock so the consumer can immediately pop again
+        executor.post(waiter->handle);
+    }
+
+    /**
+     * Returns an awaitable yielding the front element
+     */
+    PopAwaiter pop() {
+        return PopAwaiter(*this);
+    }
+
+    /**
+     * Removes the front element without suspending
+     * @param out Receives the dequeued value
+     * @return false if the queue was empty
+     */
+    bool tryPop(T& out) {
+        lock_guard<mutex> guard(lock);
+        if (items.empty()) return false;
+        out = std::move(items.front());
+        items.pop_front();
+        return true;
+    }
+
+    size_t size() {
+        lock_guard<mutex> guard(lock);
+        return items.size();
+    }
+
+    size_t waitingConsumers() {
+        lock_guard<mutex> guard(lock);
+        return waiters.size();
+    }
+};
+
+// ----------- Fire-and-forget coroutine type ------------
+/**
+ * Minimal detached task: starts eagerly and frees its frame when it finishes
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+};
+
+// ----------- Demo Consumers ------------
+
+DetachedTask printConsumer(AsyncQueue<int>& q, int id, int count) {
+    for (int i = 0; i < count; i++) {
+        int value = co_await q.pop();
+        cout << "Consumer " << id << " got " << value << endl;
+    }
+}
+
+DetachedTask countingConsumer(AsyncQueue<int>& q, int count, atomic<long long>& sum, atomic<int>& done) {
+    for (int i = 0; i < count; i++) {
+        int value = co_await q.pop();
+        sum.fetch_add(value, memory_order_relaxed);
+    }
+    done.fetch_add(1, memory_order_release);
+}
+
+/**
+ * Main function - demonstrates suspension, inline resumption and pooled resumption
+ */
+int main() {
+    cout << "=== Coroutine Async Queue Demo ===" << endl;
+
+    // Consumers suspend on an empty queue and resume inline on push
+    cout << "\n--- Inline Executor ---" << endl;
+    {
+        InlineExecutor inlineExec;
+        AsyncQueue<int> q(inlineExec);
+        printConsumer(q, 1, 2);
+        printConsumer(q, 2, 1);
+        cout << "Waiting consumers: " << q.waitingConsumers() << endl;  // Should print 2
+        q.push(10);   // Consumer 1 got 10
+        q.push(20);   // Consumer 2 got 20
+        q.push(30);   // Consumer 1 got 30
+        q.push(40);   // Buffered, nobody waiting
+        cout << "Buffered items: " << q.size() << endl;  // Should print 1
+    }
+
+    // Many logical consumers on a small thread pool
+    cout << "\n--- Thread Pool Executor (10000 consumers on 4 threads) ---" << endl;
+    {
+        const int consumers = 10000;
+        const int perConsumer = 10;
+        atomic<long long> sum(0);
+        atomic<int> done(0);
+
+        ThreadPoolExecutor pool(4);
+        AsyncQueue<int> q(pool);
+        for (int c = 0; c < consumers; c++) countingConsumer(q, perConsumer, sum, done);
+        cout << "Suspended consumers: " << q.waitingConsumers() << endl;  // Should print 10000
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < consumers * perConsumer; i++) q.push(1);
+        while (done.load(memory_order_acquire) < consumers) this_thread::yield();
+        auto end = chrono::steady_clock::now();
+
+        cout << "Items consumed: " << sum.load() << endl;  // Should print 100000
+        cout << "Elapsed: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms" << endl;
+    }
+
+    return 0;
+}
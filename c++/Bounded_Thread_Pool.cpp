@@ -0,0 +1,621 @@
+/*
+ * Bounded Thread Pool Executor
+ *
+ * The pool everybody hand-rolls around Queue (one mutex, one condition
+ * variable, one std::function queue) works, but every submit and every pop
+ * fights over the same lock, nothing stops producers from queueing without
+ * limit, and every task pays for a heap allocation. BoundedThreadPool:
+ *
+ * - Fixed worker count, each worker with its own task queue and lock.
+ *   Workers take from their own queue first and steal from the others only
+ *   when it is empty; submissions made by a worker go to its own queue, and
+ *   outside threads spread theirs round-robin from a per-thread cursor
+ * - Bounded: at most `capacity` tasks may be queued. What happens to a task
+ *   that does not fit is the RejectionPolicy:
+ *     Block       the submitter waits for room (a worker submitting to its
+ *                 own full pool runs the task instead, to avoid deadlock)
+ *     CallerRuns  the submitter runs the task itself (natural backpressure)
+ *     Drop        the task is discarded; its future reports broken_promise
+ * - Tasks are stored in a move-only wrapper with inline storage, so small
+ *   closures are not heap allocated
+ * - Idle workers sleep on a condition variable; submitters only touch it
+ *   when a worker is actually asleep
+ * - submitBulk() reserves room and fills each worker queue under a single
+ *   lock for many tasks at once
+ * - After shutdown() begins, new tasks are dropped whatever the policy. An
+ *   exception escaping an execute() task is caught and counted by its worker
+ *   (submit() tasks report it through their future instead)
+ *
+ * Operations to support:
+ * - execute(f): Fire and forget; false if dropped
+ * - submit(f): future<result of f>
+ * - submitBulk(first, last): One future per callable in the range
+ * - shutdown(): Runs everything already queued, then joins the workers
+ */
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// ----------- Task (move-only callable with inline storage) ------------
+class Task {
+private:
+    static const size_t INLINE_BYTES = 48;
+
+    struct Ops {
+        void (*run)(void* storage);
+        void (*relocate)(void* from, void* to);   // Move-construct into `to`, destroy `from`
+        void (*destroy)(void* storage);
+    };
+
+    template <typename F>
+    struct InlineOps {
+        static void run(void* s) { (*static_cast<F*>(s))(); }
+        static void relocate(void* from, void* to) {
+            new (to) F(std::move(*static_cast<F*>(from)));
+            static_cast<F*>(from)->~F();
+        }
+        static void destroy(void* s) { static_cast<F*>(s)->~F(); }
+        static constexpr Ops ops = {run, relocate, destroy};
+    };
+
+    template <typename F>
+    struct HeapOps {
+        static void run(void* s) { (**static_cast<F**>(s))(); }
+        static void relocate(void* from, void* to) { *static_cast<F**>(to) = *static_cast<F**>(from); }
+        static void destroy(void* s) { delete *static_cast<F**>(s); }
+        static constexpr Ops ops = {run, relocate, destroy};
+    };
+
+    alignas(max_align_t) unsigned char storage[INLINE_BYTES];
+    const Ops* ops = nullptr;
+
+public:
+    Task() = default;
+
+    template <typename F, typename Fn = typename decay<F>::type,
+              typename = typename enable_if<!is_same<Fn, Task>::value>::type>
+    Task(F&& f) {
+        if constexpr (sizeof(Fn) <= INLINE_BYTES && alignof(Fn) <= alignof(max_align_t) &&
+                      is_nothrow_move_constructible<Fn>::value) {
+            new (storage) Fn(std::forward<F>(f));
+            ops = &InlineOps<Fn>::ops;
+        } else {
+            *reinterpret_cast<Fn**>(storage) = new Fn(std::forward<F>(f));
+            ops = &HeapOps<Fn>::ops;
+        }
+    }
+
+    Task(Task&& other) noexcept : ops(other.ops) {
+        if (ops != nullptr) ops->relocate(other.storage, storage);
+        other.ops = nullptr;
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (ops != nullptr) ops->destroy(storage);
+            ops = other.ops;
+            if (ops != nullptr) ops->relocate(other.storage, storage);
+            other.ops = nullptr;
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    explicit operator bool() const { return ops != nullptr; }
+
+    void operator()() { ops->run(storage); }
+
+    ~Task() {
+        if (ops != nullptr) ops->destroy(storage);
+    }
+};
+
+// ----------- Bounded Thread Pool ------------
+enum class RejectionPolicy { Block, CallerRuns, Drop };
+
+struct PoolStats {
+    uint64_t executed = 0;
+    uint64_t stolen = 0;         // Tasks a worker took from another worker's queue
+    uint64_t callerRan = 0;      // CallerRuns rejections
+    uint64_t dropped = 0;        // Drop rejections and tasks submitted after shutdown()
+    uint64_t failed = 0;         // execute() tasks that threw
+    uint64_t blockedWaits = 0;   // Times a submitter waited for room
+};
+
+class BoundedThreadPool {
+private:
+    struct alignas(64) Worker {
+        mutex lock;
+        deque<Task> tasks;
+        atomic<size_t> approxSize{0};
+        uint64_t executed = 0;   // Written by the worker thread only
+        uint64_t stolen = 0;
+        uint64_t failed = 0;
+    };
+
+    const size_t capacity;
+    const RejectionPolicy policy;
+    unique_ptr<Worker[]> workers;
+    size_t workerCount;
+    vector<thread> threads;
+
+    alignas(64) atomic<size_t> queued{0};   // Reserved + queued tasks, <= capacity
+    atomic<int> sleepers{0};
+    atomic<int> blockedSubmitters{0};
+    atomic<bool> stopping{false};
+    mutex idleLock;
+    condition_variable workAvailable;
+    condition_variable roomAvailable;
+
+    atomic<uint64_t> callerRan{0};
+    atomic<uint64_t> dropped{0};
+    atomic<uint64_t> blockedWaits{0};
+
+    // Set on worker threads: the pool they belong to and their index in it
+    static thread_local const BoundedThreadPool* currentPool;
+    static thread_local size_t currentWorker;
+
+    size_t targetWorker() {
+        if (currentPool == this) return currentWorker;
+        thread_local size_t cursor = hash<thread::id>()(this_thread::get_id());
+        return cursor++ % workerCount;
+    }
+
+    /**
+     * Reserves up to `wanted` queue slots
+     * @return Number reserved (0 when full)
+     */
+    size_t reserve(size_t wanted) {
+        // seq_cst, not relaxed: a blocked submitter increments blockedSubmitters and
+        // then reads queued here, while a worker decrements queued and then reads
+        // blockedSubmitters. Only with every one of those four accesses seq_cst is at
+        // least one side guaranteed to see the other, so room is never missed.
+        size_t current = queued.load(memory_order_seq_cst);
+        for (;;) {
+            if (current >= capacity) return 0;
+            size_t grant = min(wanted, capacity - current);
+            if (queued.compare_exchange_weak(current, current + grant, memory_order_seq_cst)) return grant;
+        }
+    }
+
+    // Blocks until at least one slot is reserved; returns how many
+    size_t reserveBlocking(size_t wanted) {
+        size_t got = reserve(wanted);
+        if (got > 0) return got;
+        blockedWaits.fetch_add(1, memory_order_relaxed);
+        unique_lock<mutex> guard(idleLock);
+        blockedSubmitters.fetch_add(1);
+        while ((got = reserve(wanted)) == 0 && !stopping.load()) roomAvailable.wait(guard);
+        blockedSubmitters.fetch_sub(1);
+        return got;
+    }
+
+    /**
+     * Called right after a reservation: gives the slots back if shutdown() has
+     * begun. Reserving before checking means a worker deciding whether to exit
+     * either sees the reservation (and waits for the task) or we see stopping.
+     * @return true if the reservation was cancelled
+     */
+    bool cancelIfStopping(size_t reserved) {
+        if (!stopping.load()) return false;
+        queued.fetch_sub(reserved);
+        if (blockedSubmitters.load() > 0) {
+            lock_guard<mutex> guard(idleLock);
+            roomAvailable.notify_all();
+        }
+        return true;
+    }
+
+    void wakeWorkers(bool all) {
+        if (sleepers.load() == 0) return;
+        lock_guard<mutex> guard(idleLock);
+        if (all) workAvailable.notify_all();
+        else workAvailable.notify_one();
+    }
+
+    // Slot already reserved
+    void enqueue(Task&& task) {
+        Worker& w = workers[targetWorker()];
+        {
+            lock_guard<mutex> guard(w.lock);
+            w.tasks.push_back(std::move(task));
+            w.approxSize.store(w.tasks.size(), memory_order_relaxed);
+        }
+        wakeWorkers(false);
+    }
+
+    /**
+     * Applies the rejection policy to a task that found the queue full
+     * @return false if the task was dropped
+     */
+    bool reject(Task&& task) {
+        if (stopping.load()) return discard();
+        // A worker that blocked on its own pool could wait for room only workers can make
+        if (policy == RejectionPolicy::CallerRuns || (policy == RejectionPolicy::Block && currentPool == this)) {
+            callerRan.fetch_add(1, memory_order_relaxed);
+            task();
+            return true;
+        }
+        if (policy == RejectionPolicy::Drop) return discard();
+        size_t got = reserveBlocking(1);
+        if (got == 0 || cancelIfStopping(got)) return discard();
+        enqueue(std::move(task));
+        return true;
+    }
+
+    // The caller destroys the task, which breaks its promise
+    bool discard() {
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    bool takeFrom(Worker& w, Task& out) {
+        if (w.approxSize.load(memory_order_relaxed) == 0) return false;
+        lock_guard<mutex> guard(w.lock);
+        if (w.tasks.empty()) return false;
+        out = std::move(w.tasks.front());
+        w.tasks.pop_front();
+        w.approxSize.store(w.tasks.size(), memory_order_relaxed);
+        return true;
+    }
+
+    // Own queue first, then the others in order
+    bool findTask(size_t self, Task& out) {
+        if (takeFrom(workers[self], out)) return true;
+        for (size_t i = 1; i < workerCount; i++) {
+            if (takeFrom(workers[(self + i) % workerCount], out)) {
+                workers[self].stolen++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        currentPool = this;
+        currentWorker = self;
+        Task task;
+        for (;;) {
+            if (findTask(self, task)) {
+                queued.fetch_sub(1);   // Pairs with blockedSubmitters/queued in reserveBlocking()
+                if (blockedSubmitters.load() > 0) {
+                    lock_guard<mutex> guard(idleLock);
+                    roomAvailable.notify_one();
+                }
+                try {
+                    task();
+                } catch (...) {
+                    workers[self].failed++;   // Only execute() tasks get here; nobody is waiting for them
+                }
+                task = Task();
+                workers[self].executed++;
+                continue;
+            }
+            unique_lock<mutex> guard(idleLock);
+            sleepers.fetch_add(1);
+            // Re-check after announcing ourselves; pairs with the sleepers check in wakeWorkers
+            while (queued.load() == 0 && !stopping.load()) workAvailable.wait(guard);
+            sleepers.fetch_sub(1);
+            if (stopping.load() && queued.load() == 0) return;
+            // A reserved slot may not be pushed yet; yield so the submitter can finish
+            if (!workers[self].approxSize.load(memory_order_relaxed)) {
+                guard.unlock();
+                this_thread::yield();
+            }
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * @param threadCount Number of workers (0 = hardware threads)
+     * @param queueCapacity Most tasks that may wait at once
+     * @param rejection What to do with a task when the queue is full
+     */
+    BoundedThreadPool(size_t threadCount, size_t queueCapacity, RejectionPolicy rejection = RejectionPolicy::Block)
+        : capacity(max<size_t>(1, queueCapacity)), policy(rejection) {
+        workerCount = threadCount ? threadCount : max(1u, thread::hardware_concurrency());
+        workers.reset(new Worker[workerCount]);
+        for (size_t i = 0; i < workerCount; i++) threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    BoundedThreadPool(const BoundedThreadPool&) = delete;
+    BoundedThreadPool& operator=(const BoundedThreadPool&) = delete;
+
+    /**
+     * Queues a fire-and-forget task (no future, cheapest path). If it throws,
+     * the worker catches the exception and counts it in PoolStats::failed.
+     * @return false if the Drop policy discarded it or the pool is shutting down
+     */
+    template <typename F>
+    bool execute(F&& f) {
+        Task task(std::forward<F>(f));
+        if (reserve(1) == 0) return reject(std::move(task));
+        if (cancelIfStopping(1)) return discard();
+        enqueue(std::move(task));
+        return true;
+    }
+
+    /**
+     * Queues a task and returns a future for its result
+     */
+    template <typename F, typename R = invoke_result_t<typename decay<F>::type>>
+    future<R> submit(F&& f) {
+        packaged_task<R()> job(std::forward<F>(f));
+        future<R> result = job.get_future();
+        execute(std::move(job));
+        return result;
+    }
+
+    /**
+     * Queues every callable in [first, last): slots are reserved in bulk and each
+     * worker queue is filled under one lock acquisition
+     * @return One future per callable, in order
+     */
+    template <typename Iter, typename F = typename iterator_traits<Iter>::value_type,
+              typename R = invoke_result_t<F>>
+    vector<future<R>> submitBulk(Iter first, Iter last) {
+        vector<future<R>> results;
+        vector<Task> batch;
+        for (; first != last; ++first) {
+            packaged_task<R()> job(*first);
+            results.push_back(job.get_future());
+            batch.emplace_back(std::move(job));
+        }
+
+        size_t next = 0;
+        while (next < batch.size()) {
+            size_t granted = reserve(batch.size() - next);
+            if (granted == 0) {
+                reject(std::move(batch[next++]));
+                continue;
+            }
+            if (cancelIfStopping(granted)) {
+                for (; next < batch.size(); next++) discard();
+                break;   // The batch's destructor breaks the remaining promises
+            }
+            // Deal the granted run across workers in contiguous slices
+            size_t start = targetWorker();
+            size_t perWorker = (granted + workerCount - 1) / workerCount;
+            for (size_t i = 0; i < workerCount && granted > 0; i++) {
+                size_t take = min(perWorker, granted);
+                Worker& w = workers[(start + i) % workerCount];
+                {
+                    lock_guard<mutex> guard(w.lock);
+                    for (size_t k = 0; k < take; k++) w.tasks.push_back(std::move(batch[next++]));
+                    w.approxSize.store(w.tasks.size(), memory_order_relaxed);
+                }
+                granted -= take;
+            }
+            wakeWorkers(true);
+        }
+        return results;
+    }
+
+    /**
+     * Runs everything already queued, then joins the workers. Tasks submitted
+     * from then on are dropped, so their futures report broken_promise.
+     */
+    void shutdown() {
+        {
+            lock_guard<mutex> guard(idleLock);
+            stopping.store(true);
+        }
+        workAvailable.notify_all();
+        roomAvailable.notify_all();   // Blocked submitters give up instead of waiting for room
+        for (auto& t : threads) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    PoolStats getStats() const {   // Call after shutdown() for exact worker counts
+        PoolStats s;
+        for (size_t i = 0; i < workerCount; i++) {
+            s.executed += workers[i].executed;
+            s.stolen += workers[i].stolen;
+            s.failed += workers[i].failed;
+        }
+        s.callerRan = callerRan.load(memory_order_relaxed);
+        s.dropped = dropped.load(memory_order_relaxed);
+        s.blockedWaits = blockedWaits.load(memory_order_relaxed);
+        return s;
+    }
+
+    ~BoundedThreadPool() {
+        shutdown();
+    }
+};
+
+thread_local const BoundedThreadPool* BoundedThreadPool::currentPool = nullptr;
+thread_local size_t BoundedThreadPool::currentWorker = 0;
+
+// ----------- Baseline: the usual single-lock pool ------------
+class SimpleThreadPool {
+private:
+    mutex lock;
+    condition_variable ready;
+    queue<function<void()>> tasks;
+    vector<thread> workers;
+    bool stopping = false;
+
+public:
+    explicit SimpleThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; i++) {
+            workers.emplace_back([this] {
+                while (true) {
+                    function<void()> task;
+                    {
+                        unique_lock<mutex> guard(lock);
+                        ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+                        if (tasks.empty()) return;
+                        task = std::move(tasks.front());
+                        tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    void execute(function<void()> task) {
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push(std::move(task));
+        }
+        ready.notify_one();
+    }
+
+    ~SimpleThreadPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& t : workers) t.join();
+    }
+};
+
+// ----------- Benchmark ------------
+
+// A small closure: 4 pointers, fits Task's inline storage but not std::function's
+struct TinyJob {
+    atomic<long long>* sum;
+    long long value;
+    long long pad1;
+    long long pad2;
+    void operator()() const { sum->fetch_add(value + pad1 + pad2, memory_order_relaxed); }
+};
+
+static double millionsPerSecond(size_t tasks, chrono::steady_clock::time_point start) {
+    return tasks / chrono::duration<double>(chrono::steady_clock::now() - start).count() / 1e6;
+}
+
+/**
+ * Main function - futures, rejection policies, bulk submit and dispatch throughput
+ */
+int main() {
+    cout << "=== Bounded Thread Pool Executor Demo ===" << endl;
+
+    cout << "\n--- Futures ---" << endl;
+    {
+        BoundedThreadPool pool(2, 64);
+        future<int> answer = pool.submit([] { return 6 * 7; });
+        future<string> greeting = pool.submit([] { return string("hello from a worker"); });
+        cout << "Answer: " << answer.get() << endl;   // Should print 42
+        cout << greeting.get() << endl;
+        future<int> failing = pool.submit([]() -> int { throw runtime_error("task failed"); });
+        try {
+            failing.get();
+        } catch (const exception& e) {
+            cout << "Exception propagated: " << e.what() << endl;
+        }
+        pool.execute([] { throw runtime_error("nobody is listening"); });
+
+        pool.shutdown();
+        future<int> late = pool.submit([] { return 1; });
+        try {
+            late.get();
+        } catch (const future_error& e) {
+            cout << "Submit after shutdown: " << e.code().message() << endl;   // Broken promise
+        }
+        cout << "execute() tasks that threw: " << pool.getStats().failed << endl;   // Should print 1
+    }
+
+    cout << "\n--- Rejection Policies (1 worker, capacity 2, worker busy) ---" << endl;
+    for (RejectionPolicy policy : {RejectionPolicy::Drop, RejectionPolicy::CallerRuns, RejectionPolicy::Block}) {
+        BoundedThreadPool pool(1, 2, policy);
+        promise<void> release;
+        shared_future<void> gate = release.get_future().share();
+        pool.execute([gate] { gate.wait(); });   // Occupies the only worker
+        this_thread::sleep_for(chrono::milliseconds(20));
+
+        thread::id caller = this_thread::get_id();
+        vector<future<bool>> ranOnCaller;
+        thread releaser([&release] {
+            this_thread::sleep_for(chrono::milliseconds(50));
+            release.set_value();
+        });
+        for (int i = 0; i < 4; i++) {
+            ranOnCaller.push_back(pool.submit([caller] { return this_thread::get_id() == caller; }));
+        }
+        int done = 0, inline_ = 0, broken = 0;
+        for (auto& f : ranOnCaller) {
+            try {
+                inline_ += f.get();
+                done++;
+            } catch (const future_error&) {
+                broken++;
+            }
+        }
+        releaser.join();
+        pool.shutdown();
+        PoolStats s = pool.getStats();
+        const char* name = policy == RejectionPolicy::Drop ? "Drop      " :
+                           policy == RejectionPolicy::CallerRuns ? "CallerRuns" : "Block     ";
+        cout << name << ": " << done << " of 4 completed (" << inline_ << " on the caller), " << broken
+             << " broken promises, blocked waits " << s.blockedWaits << endl;
+    }
+
+    cout << "\n--- Bulk Submit ---" << endl;
+    {
+        BoundedThreadPool pool(2, 1 << 16);
+        vector<function<long long()>> jobs;
+        for (int i = 1; i <= 1000; i++) jobs.push_back([i] { return (long long)i * i; });
+        vector<future<long long>> results = pool.submitBulk(jobs.begin(), jobs.end());
+        long long total = 0;
+        for (auto& f : results) total += f.get();
+        cout << "Sum of squares 1..1000: " << total << endl;   // Should print 333833500
+    }
+
+    cout << "\n--- Dispatch Throughput: 2M tiny tasks, 2 workers ---" << endl;
+    const size_t tasks = 2000000;
+    {
+        atomic<long long> sum{0};
+        auto start = chrono::steady_clock::now();
+        {
+            SimpleThreadPool pool(2);
+            for (size_t i = 0; i < tasks; i++) pool.execute(TinyJob{&sum, 1, 0, 0});
+        }
+        cout << "Single-lock pool (std::function):   " << millionsPerSecond(tasks, start) << " M tasks/s" << endl;
+    }
+    {
+        atomic<long long> sum{0};
+        auto start = chrono::steady_clock::now();
+        BoundedThreadPool pool(2, 1 << 16, RejectionPolicy::Block);
+        for (size_t i = 0; i < tasks; i++) pool.execute(TinyJob{&sum, 1, 0, 0});
+        pool.shutdown();
+        PoolStats s = pool.getStats();
+        cout << "BoundedThreadPool execute():        " << millionsPerSecond(tasks, start) << " M tasks/s ("
+             << s.executed << " run, " << s.stolen << " stolen)" << endl;
+    }
+    {
+        atomic<long long> sum{0};
+        auto start = chrono::steady_clock::now();
+        BoundedThreadPool pool(2, 1 << 16, RejectionPolicy::CallerRuns);
+        for (size_t i = 0; i < tasks; i++) pool.execute(TinyJob{&sum, 1, 0, 0});
+        pool.shutdown();
+        PoolStats s = pool.getStats();
+        cout << "BoundedThreadPool, CallerRuns:      " << millionsPerSecond(tasks, start) << " M tasks/s ("
+             << s.callerRan << " run by the caller)" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+/*
+ * Variable-Length Message Byte Ring Buffer (zero-copy reserve / commit)
+ *
+ * Queue stores fixed ints, so variable-length messages have to be copied into a
+ * separately allocated object before they can be queued. ByteRingBuffer stores
+ * the bytes themselves in one preallocated ring:
+ *
+ *   Producer:  void* p = ring.reserve(n);   // space inside the ring
+ *              read(socket, p, n);          // write payload in place
+ *              ring.commit(bytesUsed);      // publish
+ *
+ *   Consumer:  MessageView m = ring.peek(); // points into the ring
+ *              handle(m.data, m.size);
+ *              ring.release();              // give the space back
+ *
+ * Record format (every record 8-byte aligned):
+ *   [uint32 length][uint32 type][payload ... padding to 8]
+ * When a record does not fit before the end of the ring, a PADDING record fills
+ * the tail so that every payload is contiguous in memory; the consumer skips it.
+ *
+ * Concurrency: single producer, single consumer, lock-free. Producer and
+ * consumer positions sit on separate cache lines (see Queue_CacheLine_Layout.cpp).
+ */
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <memory>
+
+using namespace std;
+
+// Read-only view of a committed message inside the ring
+struct MessageView {
+    const uint8_t* data;
+    size_t size;
+};
+
+class ByteRingBuffer {
+private:
+    static const uint32_t TYPE_DATA = 0;
+    static const uint32_t TYPE_PADDING = 1;
+    static const size_t HEADER_SIZE = 8;
+    static const size_t ALIGN = 8;
+
+    struct RecordHeader {
+        uint32_t length;   // Payload bytes (or bytes skipped for padding)
+        uint32_t type;
+    };
+
+    unique_ptr<uint8_t[]> buffer;
+    size_t capacity;       // Power of two, multiple of ALIGN
+    size_t mask;
+
+    // Producer-owned state
+    struct alignas(64) ProducerSide {
+        atomic<uint64_t> tail{0};    // Published write position
+        uint64_t cachedHead = 0;     // Last head seen; avoids reading the consumer line on every reserve
+        uint64_t reservedAt = 0;     // Start of the pending record
+        size_t reservedLen = 0;      // Payload bytes reserved
+        bool pending = false;
+    } producer;
+
+    // Consumer-owned state
+    struct alignas(64) ConsumerSide {
+        atomic<uint64_t> head{0};    // Released read position
+        uint64_t cachedTail = 0;     // Last tail seen
+        size_t peekedSpan = 0;       // Bytes to release for the current message
+    } consumer;
+
+    static size_t alignUp(size_t n) {
+        return (n + ALIGN - 1) & ~(ALIGN - 1);
+    }
+
+    RecordHeader* headerAt(uint64_t pos) {
+        return reinterpret_cast<RecordHeader*>(buffer.get() + (pos & mask));
+    }
+
+public:
+    /**
+     * Constructor
+     * @param capacityBytes Ring size, rounded up to a power of two (minimum 64)
+     */
+    explicit ByteRingBuffer(size_t capacityBytes) {
+        capacity = 64;
+        while (capacity < capacityBytes) capacity <<= 1;
+        mask = capacity - 1;
+        buffer.reset(new uint8_t[capacity]);
+    }
+
+    ByteRingBuffer(const ByteRingBuffer&) = delete;
+    ByteRingBuffer& operator=(const ByteRingBuffer&) = delete;
+
+    /**
+     * Largest payload that can ever be reserved
+     */
+    size_t maxMessageSize() const {
+        return capacity / 2 - HEADER_SIZE;
+    }
+
+    /**
+     * Reserves contiguous space for a payload of up to n bytes (producer only)
+     * @param n Maximum payload size the producer will write
+     * @return Pointer to write the payload to, or nullptr if the ring is full
+     *         or n is larger than maxMessageSize()
+     */
+    uint8_t* reserve(size_t n) {
+        if (producer.pending || n > maxMessageSize()) return nullptr;
+
+        uint64_t tail = producer.tail.load(memory_order_relaxed);
+        size_t recordSize = alignUp(HEADER_SIZE + n);
+        size_t offset = tail & mask;
+        size_t padding = (offset + recordSize > capacity) ? capacity - offset : 0;
+        size_t needed = padding + recordSize;
+
+        if (tail + needed - producer.cachedHead > capacity) {
+            producer.cachedHead = consumer.head.load(memory_order_acquire);
+            if (tail + needed - producer.cachedHead > capacity) return nullptr;
+        }
+
+        if (padding > 0) {
+            // Written now, published together with the record by commit()
+            RecordHeader* pad = headerAt(tail);
+            pad->length = (uint32_t)(padding - HEADER_SIZE);
+            pad->type = TYPE_PADDING;
+            tail += padding;
+        }
+
+        producer.reservedAt = tail;
+        producer.reservedLen = n;
+        producer.pending = true;
+        return buffer.get() + (tail & mask) + HEADER_SIZE;
+    }
+
+    /**
+     * Publishes the reserved record (producer only)
+     * @param used Payload bytes actually written, at most the reserved size
+     * @return false if there was no reservation or used exceeds it
+     */
+    bool commit(size_t used) {
+        if (!producer.pending || used > producer.reservedLen) return false;
+        RecordHeader* header = headerAt(producer.reservedAt);
+        header->length = (uint32_t)used;
+        header->type = TYPE_DATA;
+        producer.pending = false;
+        producer.tail.store(producer.reservedAt + alignUp(HEADER_SIZE + used), memory_order_release);
+        return true;
+    }
+
+    /**
+     * Drops the current reservation without publishing anything (producer only).
+     * A padding record written by reserve() stays unpublished and is overwritten later.
+     */
+    void abort() {
+        producer.pending = false;
+    }
+
+    /**
+     * Returns the next committed message without copying it (consumer only)
+     * @return View into the ring; data is nullptr when the ring is empty
+     */
+    MessageView peek() {
+        uint64_t head = consumer.head.load(memory_order_relaxed);
+        while (true) {
+            if (head == consumer.cachedTail) {
+                consumer.cachedTail = producer.tail.load(memory_order_acquire);
+                if (head == consumer.cachedTail) return {nullptr, 0};
+            }
+            RecordHeader* header = headerAt(head);
+            if (header->type == TYPE_PADDING) {
+                head += HEADER_SIZE + header->length;
+                consumer.head.store(head, memory_order_release);
+                continue;
+            }
+            consumer.peekedSpan = alignUp(HEADER_SIZE + header->length);
+            return {reinterpret_cast<const uint8_t*>(header) + HEADER_SIZE, header->length};
+        }
+    }
+
+    /**
+     * Frees the message returned by the last peek() (consumer only)
+     */
+    void release() {
+        if (consumer.peekedSpan == 0) return;
+        uint64_t head = consumer.head.load(memory_order_relaxed);
+        consumer.head.store(head + consumer.peekedSpan, memory_order_release);
+        consumer.peekedSpan = 0;
+    }
+
+    /**
+     * Bytes currently occupied (approximate while both sides are running)
+     */
+    size_t usedBytes() const {
+        return (size_t)(producer.tail.load(memory_order_acquire) - consumer.head.load(memory_order_acquire));
+    }
+};
+
+/**
+ * Main function - demonstrates wraparound, error handling and a threaded stream
+ */
+int main() {
+    cout << "=== Byte Ring Buffer Demo ===" << endl;
+
+    cout << "\n--- Basic Reserve / Commit / Peek / Release ---" << endl;
+    ByteRingBuffer ring(128);
+    const char* words[] = {"alpha", "bravo-bravo", "charlie"};
+    for (const char* w : words) {
+        size_t len = strlen(w);
+        uint8_t* slot = ring.reserve(len);
+        memcpy(slot, w, len);   // stands in for a socket read
+        ring.commit(len);
+    }
+    for (MessageView m = ring.peek(); m.data != nullptr; m = ring.peek()) {
+        cout << "Message (" << m.size << " bytes): " << string((const char*)m.data, m.size) << endl;
+        ring.release();
+    }
+
+    cout << "\n--- Wraparound With Padding ---" << endl;
+    // Records take 8 + 40 = 48 bytes; whenever one does not fit before the end
+    // of the 128-byte ring, a padding record fills the gap (used bytes > 48)
+    for (int round = 0; round < 4; round++) {
+        uint8_t* slot = ring.reserve(40);
+        memset(slot, 0, 40);
+        snprintf((char*)slot, 40, "record-%d", round);
+        ring.commit(40);
+        cout << "Round " << round << ": used bytes " << ring.usedBytes();
+        MessageView m = ring.peek();
+        cout << " | message: " << (const char*)m.data << " (" << m.size << " bytes)" << endl;
+        ring.release();
+    }
+
+    cout << "\n--- Error Handling ---" << endl;
+    cout << "Oversized reserve: " << (ring.reserve(1000) ? "ok" : "rejected") << endl;
+    ring.reserve(50);
+    ring.commit(50);
+    cout << "Reserve when full: " << (ring.reserve(50) ? "ok" : "rejected") << endl;
+    cout << "Commit without reserve: " << (ring.commit(1) ? "ok" : "rejected") << endl;
+    ring.peek();
+    ring.release();
+
+    cout << "\n--- Threaded Stream (1M variable-length messages) ---" << endl;
+    {
+        ByteRingBuffer stream(1 << 20);
+        const int messages = 1000000;
+        atomic<bool> ok(true);
+        size_t totalBytes = 0;
+
+        auto start = chrono::steady_clock::now();
+        thread producerThread([&]() {
+            for (int i = 0; i < messages; i++) {
+                size_t len = 16 + (i % 200);
+                uint8_t* slot;
+                while ((slot = stream.reserve(len)) == nullptr) this_thread::yield();
+                memset(slot, (uint8_t)i, len);
+                memcpy(slot, &i, sizeof(i));
+                stream.commit(len);
+            }
+        });
+        thread consumerThread([&]() {
+            for (int i = 0; i < messages; i++) {
+                MessageView m;
+                while ((m = stream.peek()).data == nullptr) this_thread::yield();
+                int seq;
+                memcpy(&seq, m.data, sizeof(seq));
+                if (seq != i || m.size != 16 + (size_t)(i % 200) || m.data[m.size - 1] != (uint8_t)i) ok = false;
+                totalBytes += m.size;
+                stream.release();
+            }
+        });
+        producerThread.join();
+        consumerThread.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << "Integrity: " << (ok ? "ok" : "CORRUPTED") << endl;
+        cout << "Throughput: " << messages / seconds / 1e6 << " M msgs/s, "
+             << totalBytes / seconds / (1 << 20) << " MiB/s" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,432 @@
+/*
+ * Indexed D-ary Heap Priority Queue
+ *
+ * Queue is strictly FIFO; many consumers need "most urgent first" instead, and
+ * some (schedulers, Dijkstra, timers) need to change or cancel an item that is
+ * already queued. IndexedDaryHeap<Key, T, D> provides that:
+ *
+ * - D-ary layout (D = 4 by default): the tree is log_D(n) levels deep instead
+ *   of log_2(n); the D children of a node are adjacent and the array is laid
+ *   out so each child group starts on a cache line (one line per level for
+ *   4-ary with 16-byte entries). D = 8 is shallower still, but comparing eight
+ *   children per level usually costs more than the saved level; the benchmark
+ *   shows it next to 4
+ * - pop() prefetches the next level's candidate groups while it is still
+ *   choosing among the current children
+ * - Entries are (key, id, value) stored inline, so a pop reads one array;
+ *   handles are mapped to positions by a compact id -> index table
+ * - Sifts move a "hole" instead of swapping: one write per level, not three
+ * - pop() uses the bottom-up strategy: walk the hole down to a leaf along the
+ *   best children, then sift the last element up (usually zero or one step)
+ * - push() returns a handle; decrease_key(handle, k) and erase(handle) are
+ *   O(log_D n) through an id -> position index. Ids are recycled, so a handle
+ *   also carries the id's generation and stale handles are rejected
+ * - Bulk constructor heapifies n items in O(n) (Floyd)
+ *
+ * With the default Compare = less<Key>, the smallest key is on top.
+ *
+ * Speed: the plain heap (Indexed = false) is the fast one, about 1.3-1.5x
+ * quicker than std::priority_queue at 1M and 4M elements. The indexed heap
+ * pays a random write to position[] for every entry a sift moves; it is
+ * somewhat ahead of std at 1M but only ties it at 4M, so choose it for
+ * decrease_key / erase, not for raw throughput.
+ *
+ * Operations to support:
+ * - push(key, value) -> Handle
+ * - top() / topKey() / pop(out)
+ * - decrease_key(handle, key) / erase(handle) / contains(handle)
+ * - size() / empty()
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <limits>
+#include <new>
+#include <cstdint>
+
+using namespace std;
+
+// ----------- Cache-line aligned allocator ------------
+template <typename U>
+struct CacheAlignedAllocator {
+    using value_type = U;
+
+    CacheAlignedAllocator() = default;
+    template <typename V>
+    CacheAlignedAllocator(const CacheAlignedAllocator<V>&) {}
+
+    U* allocate(size_t n) { return static_cast<U*>(::operator new(n * sizeof(U), align_val_t(64))); }
+    void deallocate(U* p, size_t) { ::operator delete(p, align_val_t(64)); }
+
+    template <typename V>
+    bool operator==(const CacheAlignedAllocator<V>&) const { return true; }
+    template <typename V>
+    bool operator!=(const CacheAlignedAllocator<V>&) const { return false; }
+};
+
+/**
+ * @tparam Indexed false drops the id -> position table (and with it
+ *         decrease_key/erase) for a plain, faster D-ary heap
+ */
+template <typename Key, typename T, size_t D = 4, typename Compare = less<Key>, bool Indexed = true>
+class IndexedDaryHeap {
+    static_assert(D >= 2, "a heap needs at least two children per node");
+
+public:
+    // [generation : 32][id : 32]; the generation tells a recycled id's new item
+    // apart from the one an old handle referred to
+    using Handle = uint64_t;
+    static constexpr Handle INVALID_HANDLE = numeric_limits<Handle>::max();
+
+private:
+    static constexpr uint32_t NOT_IN_HEAP = numeric_limits<uint32_t>::max();
+
+    struct Entry {
+        Key key;
+        uint32_t id;
+        T value;
+    };
+
+    // Children of logical node i sit at logical D*i+1 .. D*i+D. Storing logical i
+    // at slot i + PAD (PAD = D - 1) moves every child group to a slot that is a
+    // multiple of D, so with a 64-byte aligned array each group starts on a line.
+    static constexpr size_t PAD = D - 1;
+    vector<Entry, CacheAlignedAllocator<Entry>> slots;
+
+    vector<uint32_t> position;   // position[id] = logical index in the heap, or NOT_IN_HEAP
+    vector<uint32_t> generation; // generation[id] = bumped every time the id is freed
+    vector<uint32_t> freeIds;    // Recycled ids
+    Compare before;              // before(a, b): a comes out first
+
+    Entry& at(size_t i) { return slots[i + PAD]; }
+    const Entry& at(size_t i) const { return slots[i + PAD]; }
+    size_t count() const { return slots.size() - PAD; }
+
+    static size_t parentOf(size_t i) { return (i - 1) / D; }
+    static size_t firstChildOf(size_t i) { return i * D + 1; }
+
+    void place(size_t index, Entry&& entry) {
+        // One extra (random) write per moved entry: the price of handles
+        if constexpr (Indexed) position[entry.id] = (uint32_t)index;
+        at(index) = std::move(entry);
+    }
+
+    // Moves entry up from the hole at index until its parent comes first
+    void siftUp(size_t index, Entry&& entry) {
+        while (index > 0) {
+            size_t parent = parentOf(index);
+            if (!before(entry.key, at(parent).key)) break;
+            place(index, std::move(at(parent)));
+            index = parent;
+        }
+        place(index, std::move(entry));
+    }
+
+    // Index of the child of i that comes first; count() if i is a leaf
+    size_t bestChild(size_t i) const {
+        size_t first = firstChildOf(i);
+        size_t n = count();
+        if (first >= n) return n;
+        size_t last = first + D < n ? first + D : n;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (before(at(c).key, at(best).key)) best = c;
+        }
+        return best;
+    }
+
+    void siftDown(size_t index, Entry&& entry) {
+        size_t n = count();
+        while (true) {
+            size_t child = bestChild(index);
+            if (child == n || !before(at(child).key, entry.key)) break;
+            place(index, std::move(at(child)));
+            index = child;
+        }
+        place(index, std::move(entry));
+    }
+
+    // Removes the entry at index, filling the hole bottom-up
+    void removeAt(size_t index) {
+        if constexpr (Indexed) position[at(index).id] = NOT_IN_HEAP;
+        Entry last = std::move(slots.back());
+        slots.pop_back();
+        if (index == count()) return;   // Removed the last slot itself
+        // Walk the hole to a leaf, always promoting the best child
+        size_t n = count();
+        size_t child;
+        const Entry* base = slots.data() + PAD;
+        while ((child = bestChild(index)) != n) {
+            // The best-child choice compiles to a conditional move, so the next
+            // level's address is unknown until this level's loads finish. Asking
+            // for every grandchild group now overlaps those misses.
+            size_t grandchildren = firstChildOf(firstChildOf(child));
+            for (size_t k = 0; k < D && grandchildren + k * D < n; k++) __builtin_prefetch(base + grandchildren + k * D);
+            place(index, std::move(at(child)));
+            index = child;
+        }
+        siftUp(index, std::move(last));
+    }
+
+    static uint32_t idOf(Handle handle) { return (uint32_t)handle; }
+    Handle handleOf(uint32_t id) const { return ((Handle)generation[id] << 32) | id; }
+
+    uint32_t allocateId() {
+        if constexpr (!Indexed) return NOT_IN_HEAP;
+        if (!freeIds.empty()) {
+            uint32_t id = freeIds.back();
+            freeIds.pop_back();
+            return id;
+        }
+        position.push_back(NOT_IN_HEAP);
+        generation.push_back(0);
+        return (uint32_t)(position.size() - 1);
+    }
+
+    // Invalidates every handle to id, then makes it reusable
+    void releaseId(uint32_t id) {
+        generation[id]++;
+        freeIds.push_back(id);
+    }
+
+public:
+    explicit IndexedDaryHeap(Compare compare = Compare()) : slots(PAD), before(compare) {}
+
+    /**
+     * Bulk constructor: O(n) heapify. The item at index i gets handle i.
+     */
+    explicit IndexedDaryHeap(const vector<pair<Key, T>>& items, Compare compare = Compare()) : before(compare) {
+        slots.reserve(items.size() + PAD);
+        slots.resize(PAD);
+        if constexpr (Indexed) {
+            position.reserve(items.size());
+            generation.assign(items.size(), 0);
+        }
+        for (size_t i = 0; i < items.size(); i++) {
+            slots.push_back(Entry{items[i].first, Indexed ? (uint32_t)i : NOT_IN_HEAP, items[i].second});
+            if constexpr (Indexed) position.push_back((uint32_t)i);
+        }
+        if (count() > 1) {
+            for (size_t i = parentOf(count() - 1) + 1; i-- > 0;) {
+                Entry entry = std::move(at(i));   // The sift overwrites at(i)
+                siftDown(i, std::move(entry));
+            }
+        }
+    }
+
+    /**
+     * Inserts a value with the given priority
+     * @return Handle for decrease_key / erase; valid until the item leaves the heap
+     */
+    Handle push(const Key& key, const T& value) {
+        uint32_t id = allocateId();
+        slots.emplace_back();
+        siftUp(count() - 1, Entry{key, id, value});
+        if constexpr (!Indexed) return INVALID_HANDLE;
+        return handleOf(id);
+    }
+
+    const T& top() const { return at(0).value; }
+    const Key& topKey() const { return at(0).key; }
+    Handle topHandle() const {
+        if constexpr (!Indexed) return INVALID_HANDLE;
+        return handleOf(at(0).id);
+    }
+
+    /**
+     * Removes the highest-priority value
+     * @param out Receives the value
+     * @return false if the heap is empty
+     */
+    bool pop(T& out) {
+        if ((count() == 0)) return false;
+        uint32_t id = at(0).id;
+        out = std::move(at(0).value);
+        removeAt(0);
+        if constexpr (Indexed) releaseId(id);
+        return true;
+    }
+
+    /**
+     * @return true if the item behind handle is still queued; false for handles
+     *         whose item was popped or erased, even after its id was reused
+     */
+    bool contains(Handle handle) const {
+        uint32_t id = idOf(handle);
+        return id < position.size() && generation[id] == (uint32_t)(handle >> 32) && position[id] != NOT_IN_HEAP;
+    }
+
+    /**
+     * Moves an item closer to the top
+     * @return false if the handle is stale or key would not raise its priority
+     */
+    bool decrease_key(Handle handle, const Key& key) {
+        static_assert(Indexed, "decrease_key needs the index; use Indexed = true");
+        if (!contains(handle)) return false;
+        size_t index = position[idOf(handle)];
+        if (before(at(index).key, key)) return false;
+        Entry entry = std::move(at(index));
+        entry.key = key;
+        siftUp(index, std::move(entry));
+        return true;
+    }
+
+    /**
+     * Removes an item wherever it is in the heap
+     * @return false if the handle is stale
+     */
+    bool erase(Handle handle) {
+        static_assert(Indexed, "erase needs the index; use Indexed = true");
+        if (!contains(handle)) return false;
+        uint32_t id = idOf(handle);
+        removeAt(position[id]);
+        releaseId(id);
+        return true;
+    }
+
+    size_t size() const { return count(); }
+    bool empty() const { return (count() == 0); }
+};
+
+// ----------- Benchmarks ------------
+
+// Prevents the optimizer from discarding popped values
+static volatile long long benchmarkSink = 0;
+
+template <typename F>
+static double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Push n random keys one by one, then pop them all
+template <size_t D, bool Indexed>
+static double pushPopDary(const vector<uint64_t>& keys) {
+    return timeMs([&] {
+        IndexedDaryHeap<uint64_t, uint32_t, D, less<uint64_t>, Indexed> heap;
+        for (size_t i = 0; i < keys.size(); i++) heap.push(keys[i], (uint32_t)i);
+        uint32_t value = 0;
+        long long sum = 0;
+        while (heap.pop(value)) sum += value;
+        benchmarkSink += sum;
+    });
+}
+
+static double pushPopStd(const vector<uint64_t>& keys) {
+    return timeMs([&] {
+        priority_queue<pair<uint64_t, uint32_t>, vector<pair<uint64_t, uint32_t>>, greater<pair<uint64_t, uint32_t>>> pq;
+        for (size_t i = 0; i < keys.size(); i++) pq.emplace(keys[i], (uint32_t)i);
+        long long sum = 0;
+        while (!pq.empty()) {
+            sum += pq.top().second;
+            pq.pop();
+        }
+        benchmarkSink += sum;
+    });
+}
+
+// Bulk-build from all items, then pop them all
+template <size_t D, bool Indexed>
+static double bulkDary(const vector<pair<uint64_t, uint32_t>>& items) {
+    return timeMs([&] {
+        IndexedDaryHeap<uint64_t, uint32_t, D, less<uint64_t>, Indexed> heap(items);
+        uint32_t value = 0;
+        long long sum = 0;
+        while (heap.pop(value)) sum += value;
+        benchmarkSink += sum;
+    });
+}
+
+static double bulkStd(const vector<pair<uint64_t, uint32_t>>& items) {
+    return timeMs([&] {
+        priority_queue<pair<uint64_t, uint32_t>, vector<pair<uint64_t, uint32_t>>, greater<pair<uint64_t, uint32_t>>> pq(
+            greater<pair<uint64_t, uint32_t>>(), items);
+        long long sum = 0;
+        while (!pq.empty()) {
+            sum += pq.top().second;
+            pq.pop();
+        }
+        benchmarkSink += sum;
+    });
+}
+
+/**
+ * Main function - handles, decrease_key/erase, and benchmarks against std::priority_queue
+ */
+int main() {
+    cout << "=== Indexed D-ary Heap Priority Queue Demo ===" << endl;
+
+    cout << "\n--- Basic Operations ---" << endl;
+    IndexedDaryHeap<int, string> jobs;
+    auto backup = jobs.push(50, "nightly-backup");
+    jobs.push(10, "page-oncall");
+    auto report = jobs.push(30, "weekly-report");
+    auto cleanup = jobs.push(40, "tmp-cleanup");
+    cout << "Top: " << jobs.top() << " (priority " << jobs.topKey() << ")" << endl;   // page-oncall (10)
+
+    cout << "\n--- decrease_key / erase by Handle ---" << endl;
+    jobs.decrease_key(backup, 5);   // Backup became urgent
+    jobs.erase(report);             // Report was cancelled
+    cout << "Raise priority with a larger key: " << (jobs.decrease_key(cleanup, 99) ? "applied" : "rejected") << endl;
+    string job;
+    cout << "Pop order:";
+    while (jobs.pop(job)) cout << " " << job;
+    cout << endl;   // nightly-backup page-oncall tmp-cleanup
+    cout << "Erase stale handle: " << (jobs.erase(report) ? "erased" : "rejected") << endl;
+
+    // The popped items' ids are reused, but their old handles must not reach the new items
+    auto deploy = jobs.push(20, "deploy");
+    cout << "Old handle after its id was reused: " << (jobs.erase(cleanup) ? "erased" : "rejected")
+         << ", top is still " << jobs.top() << endl;   // rejected, deploy
+    jobs.erase(deploy);
+
+    cout << "\n--- Dijkstra With decrease_key ---" << endl;
+    // 0 -> 1 (4), 0 -> 2 (1), 2 -> 1 (2), 1 -> 3 (1), 2 -> 3 (5)
+    vector<vector<pair<int, int>>> graph = {{{1, 4}, {2, 1}}, {{3, 1}}, {{1, 2}, {3, 5}}, {}};
+    vector<int> distance(graph.size(), numeric_limits<int>::max());
+    vector<IndexedDaryHeap<int, int>::Handle> handleOf(graph.size(), IndexedDaryHeap<int, int>::INVALID_HANDLE);
+    IndexedDaryHeap<int, int> frontier;
+    distance[0] = 0;
+    handleOf[0] = frontier.push(0, 0);
+    int node = 0;
+    while (frontier.pop(node)) {
+        for (auto [next, weight] : graph[node]) {
+            int candidate = distance[node] + weight;
+            if (candidate >= distance[next]) continue;
+            distance[next] = candidate;
+            if (frontier.contains(handleOf[next])) frontier.decrease_key(handleOf[next], candidate);
+            else handleOf[next] = frontier.push(candidate, next);
+        }
+    }
+    cout << "Distances from 0:";
+    for (int d : distance) cout << " " << d;
+    cout << endl;   // 0 3 1 4
+
+    // The speedup over std belongs to the plain heap; the indexed one roughly ties std at 4M
+    cout << "\n--- Benchmark vs std::priority_queue (ms, random 64-bit keys) ---" << endl;
+    mt19937_64 rng(42);
+    for (size_t n : {1000000, 4000000}) {
+        vector<uint64_t> keys(n);
+        vector<pair<uint64_t, uint32_t>> items(n);
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = rng();
+            items[i] = {keys[i], (uint32_t)i};
+        }
+        pushPopStd(keys);   // Warm-up: page in the allocator arenas
+        cout << "n = " << n << endl;
+        cout << "  push+pop    std " << pushPopStd(keys) << " | plain 2/4/8-ary " << pushPopDary<2, false>(keys)
+             << " / " << pushPopDary<4, false>(keys) << " / " << pushPopDary<8, false>(keys) << " | indexed 4/8-ary "
+             << pushPopDary<4, true>(keys) << " / " << pushPopDary<8, true>(keys) << endl;
+        cout << "  heapify+pop std " << bulkStd(items) << " | plain 2/4/8-ary " << bulkDary<2, false>(items) << " / "
+             << bulkDary<4, false>(items) << " / " << bulkDary<8, false>(items) << " | indexed 4/8-ary "
+             << bulkDary<4, true>(items) << " / " << bulkDary<8, true>(items) << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,360 @@
+/*
+ * Deduplicating Queue
+ *
+ * Job queues often receive the same key ("refresh user 42") again while an
+ * earlier entry for it is still waiting; the consumer then does the same work
+ * twice. DedupQueue keeps a FIFO of pending entries plus a compact hash index
+ * of the keys that are pending:
+ *
+ * - push(key, x) for a key that is already pending is an O(1) no-op, or, when
+ *   a combine function was supplied, merges x into the pending entry in place
+ *   (the entry keeps its original place in line)
+ * - Once popped, the key is no longer pending and can be queued again
+ * - The index is open addressing with linear probing over node pointers
+ *   (8 bytes per slot, load factor <= 1/2, backward-shift deletion so there
+ *   are no tombstones); the key's hash is cached in its node
+ * - ShardedDedupQueue splits keys over independently locked shards by hash, so
+ *   concurrent producers on different keys rarely contend. FIFO order holds
+ *   per shard (and therefore per key), not globally.
+ *
+ * Operations to support:
+ * - push(key, x): Returns Enqueued, Dropped (duplicate) or Merged
+ * - pop(keyOut, out): Removes the oldest pending entry, false if empty
+ * - contains(key) / size() / empty()
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <queue>
+#include <unordered_set>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+enum class PushResult { Enqueued, Dropped, Merged };
+
+template <typename Key, typename T, typename Hash = hash<Key>>
+class DedupQueue {
+public:
+    using Combine = function<void(T& pending, const T& incoming)>;
+
+private:
+    // ----------- Node Class (Single Linked List Node) ------------
+    struct Node {
+        Key key;
+        T val;
+        size_t hash;
+        Node* next;
+        Node(const Key& k, const T& data, size_t h) : key(k), val(data), hash(h), next(nullptr) {}
+    };
+
+    Node* frontNode = nullptr;
+    Node* rearNode = nullptr;
+    size_t count = 0;
+
+    vector<Node*> index;   // Open addressing, null = empty slot; size is a power of two
+    size_t mask = 0;
+    Hash hasher;
+    Combine combine;
+
+    // Fibonacci mixing: std::hash of an integer is the identity, which would
+    // pile consecutive ids into one probe run
+    size_t hashOf(const Key& key) const {
+        return (size_t)((uint64_t)hasher(key) * 0x9E3779B97F4A7C15ULL >> 16);
+    }
+
+    size_t findSlot(const Key& key, size_t h) const {
+        size_t slot = h & mask;
+        while (index[slot] != nullptr) {
+            if (index[slot]->hash == h && index[slot]->key == key) return slot;
+            slot = (slot + 1) & mask;
+        }
+        return slot;   // First empty slot of the probe run
+    }
+
+    void growIndex() {
+        vector<Node*> old;
+        old.swap(index);
+        index.assign(old.empty() ? 16 : old.size() * 2, nullptr);
+        mask = index.size() - 1;
+        for (Node* node : old) {
+            if (node == nullptr) continue;
+            size_t slot = node->hash & mask;
+            while (index[slot] != nullptr) slot = (slot + 1) & mask;
+            index[slot] = node;
+        }
+    }
+
+    // Backward-shift deletion: pulls later members of the probe run into the gap
+    void eraseSlot(size_t slot) {
+        size_t gap = slot;
+        size_t probe = (slot + 1) & mask;
+        while (index[probe] != nullptr) {
+            size_t home = index[probe]->hash & mask;
+            // Move the entry if its home is not within (gap, probe] cyclically
+            if (((probe - home) & mask) >= ((probe - gap) & mask)) {
+                index[gap] = index[probe];
+                gap = probe;
+            }
+            probe = (probe + 1) & mask;
+        }
+        index[gap] = nullptr;
+    }
+
+public:
+    /**
+     * Constructor
+     * @param combineFn Optional; when set, a duplicate push merges into the pending entry
+     */
+    explicit DedupQueue(Combine combineFn = nullptr) : combine(std::move(combineFn)) {
+        growIndex();
+    }
+
+    DedupQueue(const DedupQueue&) = delete;
+    DedupQueue& operator=(const DedupQueue&) = delete;
+
+    /**
+     * Adds an entry unless its key is already pending
+     * @return Enqueued, Dropped (duplicate, no combine) or Merged
+     */
+    PushResult push(const Key& key, const T& data) {
+        size_t h = hashOf(key);
+        size_t slot = findSlot(key, h);
+        if (index[slot] != nullptr) {
+            if (!combine) return PushResult::Dropped;
+            combine(index[slot]->val, data);
+            return PushResult::Merged;
+        }
+        if ((count + 1) * 2 > index.size()) {
+            growIndex();
+            slot = findSlot(key, h);
+        }
+
+        Node* newNode = new Node(key, data, h);
+        index[slot] = newNode;
+        if (rearNode == nullptr) {
+            frontNode = rearNode = newNode;
+        } else {
+            rearNode->next = newNode;
+            rearNode = newNode;
+        }
+        count++;
+        return PushResult::Enqueued;
+    }
+
+    /**
+     * Removes the oldest pending entry; its key may be pushed again afterwards
+     * @return false if the queue is empty
+     */
+    bool pop(Key& keyOut, T& out) {
+        if (frontNode == nullptr) return false;
+        Node* temp = frontNode;
+        eraseSlot(findSlot(temp->key, temp->hash));
+        keyOut = std::move(temp->key);
+        out = std::move(temp->val);
+        frontNode = frontNode->next;
+        if (frontNode == nullptr) rearNode = nullptr;
+        delete temp;
+        count--;
+        return true;
+    }
+
+    bool contains(const Key& key) const {
+        return index[findSlot(key, hashOf(key))] != nullptr;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    ~DedupQueue() {
+        while (frontNode != nullptr) {
+            Node* temp = frontNode;
+            frontNode = frontNode->next;
+            delete temp;
+        }
+    }
+};
+
+// ----------- Sharded concurrent form ------------
+template <typename Key, typename T, typename Hash = hash<Key>>
+class ShardedDedupQueue {
+private:
+    struct alignas(64) Shard {
+        mutex lock;
+        DedupQueue<Key, T, Hash> queue;
+        explicit Shard(typename DedupQueue<Key, T, Hash>::Combine combine) : queue(std::move(combine)) {}
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    Hash hasher;
+    atomic<size_t> popCursor{0};
+
+    Shard& shardFor(const Key& key) {
+        // Top bits of the mixed hash: the shard's own index uses the low bits
+        return *shards[(size_t)(((uint64_t)hasher(key) * 0x9E3779B97F4A7C15ULL) >> 40) % shards.size()];
+    }
+
+public:
+    /**
+     * Constructor
+     * @param shardCount Number of independently locked shards
+     * @param combine Optional merge function, as for DedupQueue
+     */
+    explicit ShardedDedupQueue(size_t shardCount = 8, typename DedupQueue<Key, T, Hash>::Combine combine = nullptr) {
+        if (shardCount == 0) shardCount = 1;
+        for (size_t i = 0; i < shardCount; i++) shards.emplace_back(new Shard(combine));
+    }
+
+    PushResult push(const Key& key, const T& data) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> guard(shard.lock);
+        return shard.queue.push(key, data);
+    }
+
+    /**
+     * Pops from the shards in rotating order
+     * @return false if every shard was empty when visited
+     */
+    bool pop(Key& keyOut, T& out) {
+        size_t start = popCursor.fetch_add(1, memory_order_relaxed);
+        for (size_t i = 0; i < shards.size(); i++) {
+            Shard& shard = *shards[(start + i) % shards.size()];
+            lock_guard<mutex> guard(shard.lock);
+            if (shard.queue.pop(keyOut, out)) return true;
+        }
+        return false;
+    }
+
+    bool contains(const Key& key) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> guard(shard.lock);
+        return shard.queue.contains(key);
+    }
+
+    size_t approxSize() {
+        size_t total = 0;
+        for (auto& shard : shards) {
+            lock_guard<mutex> guard(shard->lock);
+            total += shard->queue.size();
+        }
+        return total;
+    }
+};
+
+// ----------- Benchmark ------------
+
+// Prevents the optimizer from discarding popped values
+static volatile long long benchmarkSink = 0;
+
+/**
+ * The obvious alternative: std::queue of keys plus std::unordered_set of pending keys
+ */
+static double baselineNsPerPush(const vector<int>& keys) {
+    queue<int> fifo;
+    unordered_set<int> pending;
+    auto start = chrono::steady_clock::now();
+    long long popped = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (pending.insert(keys[i]).second) fifo.push(keys[i]);
+        if ((i & 7) == 7 && !fifo.empty()) {   // Consumer keeps up with 1 in 8 pushes
+            pending.erase(fifo.front());
+            popped += fifo.front();
+            fifo.pop();
+        }
+    }
+    benchmarkSink += popped;
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / keys.size();
+}
+
+static double dedupNsPerPush(const vector<int>& keys) {
+    DedupQueue<int, int> dq;
+    auto start = chrono::steady_clock::now();
+    long long popped = 0;
+    int key = 0, value = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        dq.push(keys[i], keys[i]);
+        if ((i & 7) == 7 && dq.pop(key, value)) popped += value;
+    }
+    benchmarkSink += popped;
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / keys.size();
+}
+
+/**
+ * Main function - dropping and merging duplicates, sharded use, benchmark
+ */
+int main() {
+    cout << "=== Deduplicating Queue Demo ===" << endl;
+
+    cout << "\n--- Duplicate Pushes Are No-Ops ---" << endl;
+    DedupQueue<string, string> refresh;
+    refresh.push("user:42", "refresh profile");
+    refresh.push("user:7", "refresh profile");
+    PushResult again = refresh.push("user:42", "refresh profile");
+    cout << "Second push of user:42: " << (again == PushResult::Dropped ? "dropped" : "queued") << endl;
+    cout << "Size: " << refresh.size() << endl;   // Should print 2
+    string key, job;
+    refresh.pop(key, job);
+    cout << "Popped " << key << "; pending again? " << (refresh.contains(key) ? "yes" : "no") << endl;   // no
+    cout << "Push after pop: " << (refresh.push(key, job) == PushResult::Enqueued ? "enqueued" : "dropped") << endl;
+
+    cout << "\n--- Merging With a Combine Function ---" << endl;
+    DedupQueue<string, int> counters([](int& pending, const int& incoming) { pending += incoming; });
+    counters.push("page:/home", 1);
+    counters.push("page:/about", 1);
+    counters.push("page:/home", 5);   // Merged into the first entry, which keeps its place
+    counters.push("page:/home", 2);
+    int hits = 0;
+    while (counters.pop(key, hits)) cout << key << " += " << hits << endl;   // /home += 8, /about += 1
+
+    cout << "\n--- Sharded: 4 Producers, 2 Consumers, 500 Hot Keys ---" << endl;
+    {
+        ShardedDedupQueue<int, int> sharded(8);
+        atomic<long> enqueued{0}, dropped{0}, consumed{0};
+        atomic<bool> producing{true};
+        vector<thread> threads;
+        for (int p = 0; p < 4; p++) {
+            threads.emplace_back([&, p] {
+                for (int i = 0; i < 200000; i++) {
+                    int k = (i * 7 + p * 13) % 500;
+                    if (sharded.push(k, k) == PushResult::Enqueued) enqueued++;
+                    else dropped++;
+                }
+            });
+        }
+        for (int c = 0; c < 2; c++) {
+            threads.emplace_back([&] {
+                int k = 0, v = 0;
+                while (producing.load() || sharded.approxSize() > 0) {
+                    if (sharded.pop(k, v)) consumed++;
+                    else this_thread::yield();
+                }
+            });
+        }
+        for (int p = 0; p < 4; p++) threads[p].join();
+        producing = false;
+        for (size_t t = 4; t < threads.size(); t++) threads[t].join();
+        cout << "Pushes: " << enqueued + dropped << ", enqueued: " << enqueued << ", dropped as duplicates: " << dropped
+             << endl;
+        cout << "Consumed == enqueued: " << (consumed == enqueued ? "yes" : "NO") << endl;
+    }
+
+    cout << "\n--- Benchmark: 4M pushes over 1000 keys, 1 pop per 8 pushes ---" << endl;
+    vector<int> keys(4000000);
+    uint64_t state = 12345;
+    for (int& k : keys) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        k = (int)((state >> 33) % 1000);
+    }
+    baselineNsPerPush(keys);   // Warm-up
+    cout << "std::queue + unordered_set: " << baselineNsPerPush(keys) << " ns/push" << endl;
+    cout << "DedupQueue:                 " << dedupNsPerPush(keys) << " ns/push" << endl;
+
+    return 0;
+}
@@ -0,0 +1,376 @@
+/*
+ * Disruptor-Style Multicast Ring Buffer
+ *
+ * With Queue, every stage that needs to see an event (audit, metrics,
+ * persistence, ...) needs its own queue and its own copy. Here the event is written
+ * once into a preallocated ring slot and every consumer reads the same slot:
+ *
+ * - Sequencer:  producers claim sequence numbers (one or a batch at a time) and
+ *               publish them; claiming waits while the slowest consumer is a full
+ *               ring behind, so nothing is overwritten before everyone has read it
+ * - Consumers:  each EventProcessor owns a cursor (its own Sequence) and handles
+ *               every published event in order
+ * - Barriers:   a consumer may depend on other consumers, e.g. persistence only
+ *               sees an event after audit has processed it
+ * - Batching:   a consumer that falls behind processes everything available in one
+ *               pass and updates its cursor once per batch
+ *
+ * Design Patterns Used:
+ * - Strategy Pattern: EventHandler implementations plug into EventProcessor
+ * - Observer Pattern: every registered processor observes every event
+ */
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <climits>
+#include <cstdint>
+
+using namespace std;
+
+// ----------- Sequence: a padded atomic counter ------------
+class alignas(64) Sequence {
+    atomic<int64_t> value;
+public:
+    static const int64_t INITIAL = -1;
+
+    explicit Sequence(int64_t initial = INITIAL) : value(initial) {}
+    int64_t get() const { return value.load(memory_order_acquire); }
+    void set(int64_t v) { value.store(v, memory_order_release); }
+};
+
+int64_t minimumSequence(const vector<const Sequence*>& sequences, int64_t fallback) {
+    int64_t lowest = fallback;
+    for (const Sequence* s : sequences) lowest = min(lowest, s->get());
+    return lowest;
+}
+
+// ----------- Ring Buffer + multi-producer Sequencer ------------
+template <typename T>
+class RingBuffer {
+private:
+    vector<T> entries;
+    int64_t mask;
+    int indexShift;                       // log2(capacity)
+    unique_ptr<atomic<int32_t>[]> available;   // Lap number of the last publish per slot
+
+    alignas(64) atomic<int64_t> claimed{Sequence::INITIAL};   // Highest claimed sequence
+    alignas(64) atomic<int64_t> cachedGating{Sequence::INITIAL};  // Slowest consumer last seen
+    vector<const Sequence*> gating;       // Consumers at the end of the dependency graph
+
+public:
+    /**
+     * Constructor
+     * @param capacity Number of slots, must be a power of two
+     */
+    explicit RingBuffer(size_t capacity) : entries(capacity), mask((int64_t)capacity - 1) {
+        indexShift = 0;
+        while ((size_t(1) << indexShift) < capacity) indexShift++;
+        available.reset(new atomic<int32_t>[capacity]);
+        for (size_t i = 0; i < capacity; i++) available[i].store(-1, memory_order_relaxed);
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t capacity() const { return entries.size(); }
+
+    /**
+     * Registers the consumer cursors producers must never overtake
+     * (normally the last processors of every dependency chain)
+     */
+    void addGatingSequences(const vector<const Sequence*>& sequences) {
+        gating.insert(gating.end(), sequences.begin(), sequences.end());
+    }
+
+    /**
+     * Claims the next n sequences, waiting while the ring is full
+     * @param n Batch size, at most capacity()
+     * @return The highest claimed sequence; the batch is [result - n + 1, result]
+     */
+    int64_t next(int64_t n = 1) {
+        int64_t current = claimed.fetch_add(n, memory_order_acq_rel);
+        int64_t high = current + n;
+        int64_t wrapPoint = high - (int64_t)capacity();
+        if (wrapPoint > cachedGating.load(memory_order_relaxed)) {
+            int64_t slowest;
+            while (wrapPoint > (slowest = minimumSequence(gating, high))) this_thread::yield();
+            cachedGating.store(slowest, memory_order_relaxed);
+        }
+        return high;
+    }
+
+    T& get(int64_t sequence) {
+        return entries[sequence & mask];
+    }
+
+    /**
+     * Makes the sequences [low, high] visible to consumers
+     */
+    void publish(int64_t low, int64_t high) {
+        for (int64_t s = low; s <= high; s++) {
+            available[s & mask].store((int32_t)(s >> indexShift), memory_order_release);
+        }
+    }
+
+    void publish(int64_t sequence) {
+        publish(sequence, sequence);
+    }
+
+    /**
+     * Convenience: claim one slot, let the caller fill it in place, publish
+     */
+    template <typename Writer>
+    void publishEvent(Writer writer) {
+        int64_t seq = next();
+        writer(get(seq), seq);
+        publish(seq);
+    }
+
+    bool isAvailable(int64_t sequence) const {
+        return available[sequence & mask].load(memory_order_acquire) == (int32_t)(sequence >> indexShift);
+    }
+
+    /**
+     * Highest sequence in [low, high] such that everything from low up to it is published
+     */
+    int64_t highestPublished(int64_t low, int64_t high) const {
+        for (int64_t s = low; s <= high; s++) {
+            if (!isAvailable(s)) return s - 1;
+        }
+        return high;
+    }
+
+    int64_t claimedCursor() const {
+        return claimed.load(memory_order_acquire);
+    }
+};
+
+// ----------- Sequence Barrier ------------
+/**
+ * Tells a consumer how far it may read: up to what producers have published and
+ * (if it has dependencies) what every upstream consumer has finished
+ */
+template <typename T>
+class SequenceBarrier {
+    RingBuffer<T>& ring;
+    vector<const Sequence*> dependencies;
+    atomic<bool> alerted{false};
+
+public:
+    SequenceBarrier(RingBuffer<T>& rb, vector<const Sequence*> deps) : ring(rb), dependencies(std::move(deps)) {}
+
+    /**
+     * Waits until `sequence` can be read
+     * @return Highest readable sequence (>= sequence), or INITIAL if alerted
+     */
+    int64_t waitFor(int64_t sequence) {
+        while (true) {
+            if (alerted.load(memory_order_acquire)) return Sequence::INITIAL;
+            int64_t upper = dependencies.empty() ? ring.claimedCursor()
+                                                 : minimumSequence(dependencies, LLONG_MAX);
+            if (upper >= sequence) {
+                int64_t ready = ring.highestPublished(sequence, upper);
+                if (ready >= sequence) return ready;
+            }
+            this_thread::yield();
+        }
+    }
+
+    void alert() {
+        alerted.store(true, memory_order_release);
+    }
+};
+
+// ----------- Event Handlers (Strategy) ------------
+template <typename T>
+class EventHandler {
+public:
+    /**
+     * @param event The shared slot; handlers must not modify it
+     * @param sequence The event's sequence number
+     * @param endOfBatch true for the last event of the current batch
+     */
+    virtual void onEvent(const T& event, int64_t sequence, bool endOfBatch) = 0;
+    virtual string getName() = 0;
+    virtual ~EventHandler() = default;
+};
+
+// ----------- Event Processor: one consumer thread ------------
+template <typename T>
+class EventProcessor {
+    RingBuffer<T>& ring;
+    SequenceBarrier<T> barrier;
+    EventHandler<T>& handler;
+    Sequence cursor;
+    thread worker;
+    int64_t batches = 0;
+
+    void run() {
+        int64_t nextSeq = cursor.get() + 1;
+        while (true) {
+            int64_t available = barrier.waitFor(nextSeq);
+            if (available == Sequence::INITIAL) return;
+            for (int64_t s = nextSeq; s <= available; s++) {
+                handler.onEvent(ring.get(s), s, s == available);
+            }
+            cursor.set(available);    // One store per batch
+            batches++;
+            nextSeq = available + 1;
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * @param rb Shared ring buffer
+     * @param h Handler invoked for every event
+     * @param dependsOn Processors that must finish an event before this one sees it
+     */
+    EventProcessor(RingBuffer<T>& rb, EventHandler<T>& h, const vector<EventProcessor*>& dependsOn = {})
+        : ring(rb), barrier(rb, cursorsOf(dependsOn)), handler(h) {}
+
+    static vector<const Sequence*> cursorsOf(const vector<EventProcessor*>& processors) {
+        vector<const Sequence*> out;
+        for (EventProcessor* p : processors) out.push_back(&p->cursor);
+        return out;
+    }
+
+    const Sequence* getCursor() const { return &cursor; }
+
+    void start() {
+        worker = thread([this]() { run(); });
+    }
+
+    /**
+     * Waits until everything up to `lastSequence` is handled, then stops the thread
+     */
+    void drainAndStop(int64_t lastSequence) {
+        while (cursor.get() < lastSequence) this_thread::yield();
+        barrier.alert();
+        if (worker.joinable()) worker.join();
+    }
+
+    int64_t batchCount() const { return batches; }
+
+    ~EventProcessor() {
+        barrier.alert();
+        if (worker.joinable()) worker.join();
+    }
+};
+
+// ----------- Demo event and handlers ------------
+
+struct PaymentEvent {
+    int64_t paymentId = 0;
+    double amount = 0.0;
+    int gateway = 0;       // 0 = VISA, 1 = MASTERCARD
+};
+
+class AuditHandler : public EventHandler<PaymentEvent> {
+public:
+    atomic<int64_t> lastAudited{-1};
+    int64_t outOfOrder = 0;
+    void onEvent(const PaymentEvent& event, int64_t, bool) override {
+        if (event.paymentId <= lastAudited.load(memory_order_relaxed)) outOfOrder++;
+        lastAudited.store(event.paymentId, memory_order_relaxed);
+    }
+    string getName() override { return "Audit"; }
+};
+
+class MetricsHandler : public EventHandler<PaymentEvent> {
+public:
+    int64_t count[2] = {0, 0};
+    double volume = 0.0;
+    void onEvent(const PaymentEvent& event, int64_t, bool) override {
+        count[event.gateway]++;
+        volume += event.amount;
+    }
+    string getName() override { return "Metrics"; }
+};
+
+/**
+ * Persistence runs behind Audit; it records how often it saw an event the audit
+ * stage had not reached yet (must stay 0)
+ */
+class PersistenceHandler : public EventHandler<PaymentEvent> {
+    const AuditHandler& audit;
+public:
+    int64_t persisted = 0;
+    int64_t aheadOfAudit = 0;
+    int64_t flushes = 0;
+    explicit PersistenceHandler(const AuditHandler& a) : audit(a) {}
+    void onEvent(const PaymentEvent& event, int64_t, bool endOfBatch) override {
+        if (event.paymentId > audit.lastAudited.load(memory_order_relaxed)) aheadOfAudit++;
+        persisted++;
+        if (endOfBatch) flushes++;   // One write per batch instead of per event
+    }
+    string getName() override { return "Persistence"; }
+};
+
+/**
+ * Main function - fan-out with a dependency and batch claiming
+ */
+int main() {
+    cout << "=== Disruptor Ring Buffer Demo ===" << endl;
+
+    const int64_t events = 1000000;
+    const int producers = 2;
+    const int64_t claimBatch = 16;
+
+    RingBuffer<PaymentEvent> ring(4096);
+    AuditHandler audit;
+    MetricsHandler metrics;
+    PersistenceHandler persistence(audit);
+
+    // audit -> persistence, metrics independent
+    EventProcessor<PaymentEvent> auditProc(ring, audit);
+    EventProcessor<PaymentEvent> metricsProc(ring, metrics);
+    EventProcessor<PaymentEvent> persistProc(ring, persistence, {&auditProc});
+    ring.addGatingSequences({metricsProc.getCursor(), persistProc.getCursor()});
+
+    auditProc.start();
+    metricsProc.start();
+    persistProc.start();
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> producerThreads;
+    for (int p = 0; p < producers; p++) {
+        producerThreads.emplace_back([&]() {
+            for (int64_t done = 0; done < events / producers; done += claimBatch) {
+                int64_t high = ring.next(claimBatch);      // Batch claim
+                int64_t low = high - claimBatch + 1;
+                for (int64_t s = low; s <= high; s++) {
+                    PaymentEvent& e = ring.get(s);         // Write in place, no copy
+                    e.paymentId = s;
+                    e.amount = 10.0;
+                    e.gateway = (int)(s & 1);
+                }
+                ring.publish(low, high);
+            }
+        });
+    }
+    for (auto& t : producerThreads) t.join();
+
+    int64_t last = ring.claimedCursor();
+    auditProc.drainAndStop(last);
+    metricsProc.drainAndStop(last);
+    persistProc.drainAndStop(last);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n--- Results ---" << endl;
+    cout << "Events published: " << last + 1 << endl;
+    cout << "Audit:       out-of-order = " << audit.outOfOrder << " | batches = " << auditProc.batchCount() << endl;
+    cout << "Metrics:     VISA = " << metrics.count[0] << ", MASTERCARD = " << metrics.count[1]
+         << ", volume = " << metrics.volume << endl;
+    cout << "Persistence: persisted = " << persistence.persisted
+         << " | ahead of audit = " << persistence.aheadOfAudit
+         << " | flushes = " << persistence.flushes << endl;
+    cout << "Throughput: " << (last + 1) / seconds / 1e6 << " M events/s delivered to 3 consumers" << endl;
+
+    return 0;
+}
@@ -0,0 +1,421 @@
+/*
+ * Epoch-Based Memory Reclamation (EBR)
+ *
+ * A lock-free container cannot delete a node the moment it is unlinked: another
+ * thread may still be reading it. EpochDomain defers those frees until no thread
+ * can hold a reference any more:
+ *
+ * - A global epoch counter; each registered thread announces the epoch it saw
+ *   when it enters a critical section (EpochGuard) and clears it on exit
+ * - Unlinked nodes are retired into the calling thread's own retire list, tagged
+ *   with the current epoch (no shared state touched, no allocation per node
+ *   beyond the amortized vector growth)
+ * - Every scanInterval retirements the thread tries to advance the epoch and
+ *   frees, in one batch, everything retired two or more epochs ago
+ * - Garbage is bounded: once a thread holds maxGarbage unfreed nodes, retire()
+ *   keeps helping to advance the epoch until the backlog shrinks
+ * - Threads register and unregister at any time; records are recycled and
+ *   leftovers of exiting threads are adopted by the domain
+ *
+ * Cost on the hot path: a plain store to enter and one to exit. The store-load
+ * fence a reader would need is paid by the (rare) epoch advance instead, through
+ * Linux membarrier(), which briefly interrupts every running thread of the
+ * process. Without membarrier support the guard falls back to an atomic exchange.
+ *
+ * Operations to support:
+ * - registerThread(): Returns a handle the thread uses for all later calls
+ * - EpochGuard guard(handle): Protects every node read inside its scope
+ * - handle.retire(ptr): Schedules ptr for deletion once it is unreachable
+ */
+
+#include <iostream>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace std;
+
+class EpochDomain {
+private:
+    // ----------- Retired node ------------
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;        // Global epoch at retirement
+    };
+
+    // ----------- Per-thread record ------------
+    // One cache line per thread: the announcement is written on every guard
+    // entry and must not share a line with another thread's announcement.
+    struct alignas(64) ThreadRecord {
+        atomic<uint64_t> announced{0};   // (epoch << 1) | 1 while inside a guard, 0 outside
+        atomic<bool> inUse{false};
+        ThreadRecord* next = nullptr;    // Registry list, never unlinked until the domain dies
+
+        // Owner-only state
+        vector<Retired> retired;         // Ordered by epoch
+        size_t sinceScan = 0;
+        unsigned nesting = 0;
+    };
+
+    atomic<uint64_t> globalEpoch{1};
+    atomic<ThreadRecord*> registry{nullptr};
+    bool asymmetricFence;                // membarrier() available: readers skip the fence
+    size_t scanInterval;
+    size_t maxGarbage;
+
+    mutex orphanLock;
+    vector<Retired> orphans;             // Left behind by unregistered threads
+
+    atomic<uint64_t> freedCount{0};
+    atomic<uint64_t> advanceCount{0};
+
+    /**
+     * Moves the epoch forward if every thread inside a guard has seen the current one
+     * @return The global epoch after the attempt
+     */
+    uint64_t tryAdvance() {
+        uint64_t epoch = globalEpoch.load(memory_order_seq_cst);
+        // Heavy side of the asymmetric fence: every reader's announcement store is
+        // now visible, and its later node loads cannot have been hoisted above it
+        if (asymmetricFence) syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        for (ThreadRecord* r = registry.load(memory_order_acquire); r != nullptr; r = r->next) {
+            uint64_t state = r->announced.load(memory_order_seq_cst);
+            if ((state & 1) && (state >> 1) != epoch) return epoch;   // Straggler still in an older epoch
+        }
+        if (globalEpoch.compare_exchange_strong(epoch, epoch + 1, memory_order_seq_cst)) {
+            advanceCount.fetch_add(1, memory_order_relaxed);
+            return epoch + 1;
+        }
+        return epoch;   // Somebody else advanced it
+    }
+
+    // Frees the prefix of list retired at least two epochs before `epoch`
+    size_t freeExpired(vector<Retired>& list, uint64_t epoch) {
+        size_t n = 0;
+        while (n < list.size() && list[n].epoch + 2 <= epoch) {
+            list[n].deleter(list[n].ptr);
+            n++;
+        }
+        list.erase(list.begin(), list.begin() + n);
+        freedCount.fetch_add(n, memory_order_relaxed);
+        return n;
+    }
+
+    void scan(ThreadRecord& record) {
+        record.sinceScan = 0;
+        uint64_t epoch = tryAdvance();
+        freeExpired(record.retired, epoch);
+
+        unique_lock<mutex> lock(orphanLock, try_to_lock);
+        if (lock.owns_lock() && !orphans.empty()) freeExpired(orphans, epoch);
+    }
+
+public:
+    class EpochGuard;
+
+    // ----------- Thread handle ------------
+    class ThreadHandle {
+    private:
+        EpochDomain* domain;
+        ThreadRecord* record;
+
+        friend class EpochDomain;
+        friend class EpochGuard;
+        ThreadHandle(EpochDomain* d, ThreadRecord* r) : domain(d), record(r) {}
+
+    public:
+        ThreadHandle(ThreadHandle&& other) noexcept : domain(other.domain), record(other.record) {
+            other.record = nullptr;
+        }
+        ThreadHandle(const ThreadHandle&) = delete;
+        ThreadHandle& operator=(const ThreadHandle&) = delete;
+
+        /**
+         * Schedules ptr for `delete` once no guard can still observe it.
+         * Call only after ptr has been unlinked from the shared structure.
+         */
+        template <typename T>
+        void retire(T* ptr) {
+            retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+        }
+
+        void retire(void* ptr, void (*deleter)(void*)) {
+            ThreadRecord& r = *record;
+            r.retired.push_back({ptr, deleter, domain->globalEpoch.load(memory_order_relaxed)});
+            if (++r.sinceScan >= domain->scanInterval) domain->scan(r);
+            // Bounded garbage: help the epoch along until the backlog shrinks.
+            // Retiring inside a guard would wait on ourselves, so only do it outside.
+            while (r.nesting == 0 && r.retired.size() >= domain->maxGarbage) {
+                domain->scan(r);
+                if (r.retired.size() >= domain->maxGarbage) this_thread::yield();
+            }
+        }
+
+        size_t pendingCount() const { return record->retired.size(); }
+
+        ~ThreadHandle() {
+            if (record != nullptr) domain->unregister(record);
+        }
+    };
+
+    // ----------- RAII critical section ------------
+    class EpochGuard {
+    private:
+        ThreadRecord& record;
+
+    public:
+        explicit EpochGuard(ThreadHandle& handle) : record(*handle.record) {
+            if (record.nesting++ == 0) {
+                EpochDomain* domain = handle.domain;
+                uint64_t announcement = (domain->globalEpoch.load(memory_order_relaxed) << 1) | 1;
+                // The announcement must be visible before any node pointer is read
+                if (domain->asymmetricFence) {
+                    record.announced.store(announcement, memory_order_relaxed);
+                    atomic_signal_fence(memory_order_seq_cst);   // Compiler-only; tryAdvance() does the rest
+                } else {
+                    record.announced.exchange(announcement, memory_order_seq_cst);
+                }
+            }
+        }
+
+        ~EpochGuard() {
+            if (--record.nesting == 0) record.announced.store(0, memory_order_release);
+        }
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+    };
+
+    /**
+     * Constructor
+     * @param scanInterval Retirements between epoch-advance attempts (batch size)
+     * @param maxGarbage Unfreed nodes per thread before retire() starts helping
+     */
+    explicit EpochDomain(size_t scanInterval = 64, size_t maxGarbage = 4096)
+        : scanInterval(scanInterval ? scanInterval : 1),
+          maxGarbage(maxGarbage > scanInterval ? maxGarbage : scanInterval * 2) {
+        asymmetricFence = syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+    }
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * Registers the calling thread; reuses the record of a thread that has left
+     */
+    ThreadHandle registerThread() {
+        for (ThreadRecord* r = registry.load(memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->inUse.load(memory_order_relaxed) && r->inUse.compare_exchange_strong(expected, true)) {
+                return ThreadHandle(this, r);
+            }
+        }
+        ThreadRecord* fresh = new ThreadRecord();
+        fresh->inUse.store(true, memory_order_relaxed);
+        ThreadRecord* head = registry.load(memory_order_relaxed);
+        do {
+            fresh->next = head;
+        } while (!registry.compare_exchange_weak(head, fresh, memory_order_release, memory_order_relaxed));
+        return ThreadHandle(this, fresh);
+    }
+
+    uint64_t epoch() const { return globalEpoch.load(memory_order_relaxed); }
+    bool usesAsymmetricFence() const { return asymmetricFence; }
+    uint64_t freed() const { return freedCount.load(memory_order_relaxed); }
+    uint64_t advances() const { return advanceCount.load(memory_order_relaxed); }
+
+    /**
+     * Destructor - all threads must have unregistered; frees everything still pending
+     */
+    ~EpochDomain() {
+        ThreadRecord* r = registry.load(memory_order_acquire);
+        while (r != nullptr) {
+            ThreadRecord* temp = r;
+            r = r->next;
+            for (Retired& item : temp->retired) item.deleter(item.ptr);
+            delete temp;
+        }
+        for (Retired& item : orphans) item.deleter(item.ptr);
+    }
+
+private:
+    void unregister(ThreadRecord* record) {
+        record->announced.store(0, memory_order_release);
+        record->nesting = 0;
+        scan(*record);
+        if (!record->retired.empty()) {
+            lock_guard<mutex> lock(orphanLock);
+            orphans.insert(orphans.end(), record->retired.begin(), record->retired.end());
+            record->retired.clear();
+        }
+        record->inUse.store(false, memory_order_release);
+    }
+};
+
+using EpochGuard = EpochDomain::EpochGuard;
+
+// ----------- Example client: lock-free Michael-Scott queue ------------
+/**
+ * The LinkedList-based Queue made lock-free. Without EBR, pop() could not delete
+ * the old dummy node because a concurrent pop() might still be reading it.
+ */
+template <typename T>
+class LockFreeQueue {
+private:
+    struct Node {
+        T val;
+        atomic<Node*> next{nullptr};
+        static atomic<long> live;
+        explicit Node(const T& data) : val(data) { live.fetch_add(1, memory_order_relaxed); }
+        ~Node() { live.fetch_sub(1, memory_order_relaxed); }
+    };
+
+    alignas(64) atomic<Node*> frontNode;   // Dummy node; the real front is frontNode->next
+    alignas(64) atomic<Node*> rearNode;
+
+public:
+    LockFreeQueue() {
+        Node* dummy = new Node(T());
+        frontNode.store(dummy);
+        rearNode.store(dummy);
+    }
+
+    void push(EpochDomain::ThreadHandle& handle, const T& data) {
+        Node* newNode = new Node(data);
+        EpochGuard guard(handle);
+        while (true) {
+            Node* rear = rearNode.load(memory_order_acquire);
+            Node* next = rear->next.load(memory_order_acquire);
+            if (next != nullptr) {   // Rear is lagging: help it forward
+                rearNode.compare_exchange_weak(rear, next, memory_order_release, memory_order_relaxed);
+                continue;
+            }
+            if (rear->next.compare_exchange_weak(next, newNode, memory_order_release, memory_order_relaxed)) {
+                rearNode.compare_exchange_strong(rear, newNode, memory_order_release, memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    bool pop(EpochDomain::ThreadHandle& handle, T& out) {
+        Node* oldFront;
+        {
+            EpochGuard guard(handle);
+            while (true) {
+                oldFront = frontNode.load(memory_order_acquire);
+                Node* next = oldFront->next.load(memory_order_acquire);
+                if (next == nullptr) return false;
+                Node* rear = rearNode.load(memory_order_acquire);
+                if (oldFront == rear) {
+                    rearNode.compare_exchange_weak(rear, next, memory_order_release, memory_order_relaxed);
+                    continue;
+                }
+                if (frontNode.compare_exchange_weak(oldFront, next, memory_order_acq_rel, memory_order_relaxed)) {
+                    out = next->val;   // next is the new dummy; EBR keeps it alive for us
+                    break;
+                }
+            }
+        }
+        handle.retire(oldFront);   // Other poppers may still be reading it
+        return true;
+    }
+
+    static long liveNodes() { return Node::live.load(); }
+
+    ~LockFreeQueue() {
+        Node* node = frontNode.load();
+        while (node != nullptr) {
+            Node* temp = node;
+            node = node->next.load();
+            delete temp;
+        }
+    }
+};
+
+template <typename T>
+atomic<long> LockFreeQueue<T>::Node::live{0};
+
+/**
+ * Main function - concurrent queue on top of EBR, garbage bound and overhead
+ */
+int main() {
+    cout << "=== Epoch-Based Reclamation Demo ===" << endl;
+
+    cout << "\n--- Lock-Free Queue, 2 Producers / 2 Consumers ---" << endl;
+    const int perProducer = 200000;
+    {
+        EpochDomain domain(64, 1024);
+        LockFreeQueue<long> queue;
+        atomic<long> consumedSum{0}, consumedCount{0};
+        size_t worstBacklog = 0;
+        mutex backlogLock;
+
+        vector<thread> threads;
+        for (int p = 0; p < 2; p++) {
+            threads.emplace_back([&, p] {
+                auto handle = domain.registerThread();
+                for (int i = 1; i <= perProducer; i++) queue.push(handle, (long)i + p * perProducer);
+            });
+        }
+        for (int c = 0; c < 2; c++) {
+            threads.emplace_back([&] {
+                auto handle = domain.registerThread();
+                long value = 0;
+                size_t backlog = 0;
+                while (consumedCount.load() < 2L * perProducer) {
+                    if (queue.pop(handle, value)) {
+                        consumedSum += value;
+                        consumedCount++;
+                        if (handle.pendingCount() > backlog) backlog = handle.pendingCount();
+                    }
+                }
+                lock_guard<mutex> lock(backlogLock);
+                if (backlog > worstBacklog) worstBacklog = backlog;
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        long expected = 2L * perProducer * (2L * perProducer + 1) / 2;
+        cout << "Sum check: " << (consumedSum.load() == expected ? "ok" : "MISMATCH") << endl;
+        cout << "Epoch advances: " << domain.advances() << ", nodes freed so far: " << domain.freed() << endl;
+        cout << "Worst per-thread backlog: " << worstBacklog << " (bound 1024)" << endl;
+    }
+    cout << "Live nodes after queue and domain are gone: " << LockFreeQueue<long>::liveNodes() << endl;  // 0
+
+    cout << "\n--- Thread Registration Is Recycled ---" << endl;
+    {
+        EpochDomain domain;
+        for (int round = 0; round < 3; round++) {
+            thread([&] { auto handle = domain.registerThread(); }).join();
+        }
+        auto a = domain.registerThread();
+        cout << "Registered 4 threads over time; records reused, epoch = " << domain.epoch() << endl;
+    }
+
+    cout << "\n--- Per-Operation Overhead (single thread) ---" << endl;
+    {
+        EpochDomain domain;
+        auto handle = domain.registerThread();
+        const int ops = 5000000;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < ops; i++) {
+            EpochGuard guard(handle);
+        }
+        auto mid = chrono::steady_clock::now();
+        for (int i = 0; i < ops; i++) handle.retire(new int(i));
+        auto end = chrono::steady_clock::now();
+        cout << "Reader fence: " << (domain.usesAsymmetricFence() ? "membarrier (asymmetric)" : "atomic exchange") << endl;
+        cout << "guard enter+exit: " << chrono::duration<double, nano>(mid - start).count() / ops << " ns | "
+             << "new + retire + batched delete: " << chrono::duration<double, nano>(end - mid).count() / ops << " ns"
+             << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Deficit-Round-Robin Fair Queue
+ *
+ * With a single shared Queue, one noisy tenant that pushes 10,000 jobs delays
+ * every other tenant behind them. FairQueue keeps one FIFO per tenant key and
+ * dequeues with deficit round robin (DRR):
+ *
+ * - Each tenant has a weight (quantum). When its turn comes it earns `weight`
+ *   credits and may dequeue that many items before the next tenant is served.
+ * - Only tenants with pending items are on the active ring, so an idle tenant
+ *   costs nothing at dequeue time.
+ * - Each tenant can have a depth limit; pushes beyond it are rejected, so one
+ *   tenant cannot consume all of the memory either.
+ *
+ * Complexity: push and pop are O(1) (one hash lookup for push, none for pop),
+ * independent of the number of tenants, active or not.
+ *
+ * Operations to support:
+ * - push(key, x): Appends x to the tenant's FIFO, false if the tenant is at its limit
+ * - pop(out, keyOut): Removes the next item in DRR order, false if all tenants are empty
+ * - setWeight(key, w) / setDepthLimit(key, n): Per-tenant configuration
+ */
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include <map>
+#include <cstdint>
+
+using namespace std;
+
+template <typename Key, typename T>
+class FairQueue {
+private:
+    // ----------- Node Class (Single Linked List Node) ------------
+    struct Node {
+        T val;
+        Node* next;
+        explicit Node(const T& data) : val(data), next(nullptr) {}
+    };
+
+    // ----------- Per-tenant state ------------
+    struct Tenant {
+        Key key;
+        Node* frontNode = nullptr;
+        Node* rearNode = nullptr;
+        size_t count = 0;
+        unsigned weight;
+        size_t depthLimit;
+        unsigned deficit = 0;          // Credits left in the current turn
+        bool active = false;           // On the active ring
+        Tenant* nextActive = nullptr;  // Intrusive FIFO of active tenants
+
+        Tenant(const Key& k, unsigned w, size_t limit) : key(k), weight(w), depthLimit(limit) {}
+
+        ~Tenant() {
+            while (frontNode != nullptr) {
+                Node* temp = frontNode;
+                frontNode = frontNode->next;
+                delete temp;
+            }
+        }
+    };
+
+    unordered_map<Key, unique_ptr<Tenant>> tenants;
+    Tenant* activeHead = nullptr;      // Tenant currently being served
+    Tenant* activeTail = nullptr;
+    size_t totalCount = 0;
+    unsigned defaultWeight;
+    size_t defaultDepthLimit;
+
+    Tenant& tenantFor(const Key& key) {
+        auto it = tenants.find(key);
+        if (it != tenants.end()) return *it->second;
+        Tenant* created = new Tenant(key, defaultWeight, defaultDepthLimit);
+        tenants.emplace(key, unique_ptr<Tenant>(created));
+        return *created;
+    }
+
+    void activate(Tenant& tenant) {
+        tenant.active = true;
+        tenant.nextActive = nullptr;
+        tenant.deficit = 0;
+        if (activeTail == nullptr) {
+            activeHead = activeTail = &tenant;
+            activeHead->deficit = activeHead->weight;   // First in line starts its turn
+        } else {
+            activeTail->nextActive = &tenant;
+            activeTail = &tenant;
+        }
+    }
+
+    // Removes the head tenant from the ring and gives the next one its quantum
+    Tenant* advance(bool requeue) {
+        Tenant* done = activeHead;
+        activeHead = done->nextActive;
+        done->nextActive = nullptr;
+        if (activeHead == nullptr) activeTail = nullptr;
+        if (requeue) {
+            if (activeTail == nullptr) {
+                activeHead = activeTail = done;
+            } else {
+                activeTail->nextActive = done;
+                activeTail = done;
+            }
+        } else {
+            done->active = false;
+            done->deficit = 0;
+        }
+        if (activeHead != nullptr) activeHead->deficit += activeHead->weight;
+        return activeHead;
+    }
+
+public:
+    /**
+     * Constructor
+     * @param weight Default quantum for tenants without an explicit weight
+     * @param depthLimit Default maximum pending items per tenant
+     */
+    explicit FairQueue(unsigned weight = 1, size_t depthLimit = SIZE_MAX)
+        : defaultWeight(weight ? weight : 1), defaultDepthLimit(depthLimit) {}
+
+    FairQueue(const FairQueue&) = delete;
+    FairQueue& operator=(const FairQueue&) = delete;
+
+    /**
+     * Sets a tenant's weight; a tenant with weight 3 gets three items per turn
+     */
+    void setWeight(const Key& key, unsigned weight) {
+        tenantFor(key).weight = weight ? weight : 1;
+    }
+
+    void setDepthLimit(const Key& key, size_t limit) {
+        tenantFor(key).depthLimit = limit;
+    }
+
+    /**
+     * Appends an item to the tenant's FIFO
+     * @return false if the tenant already holds depthLimit items
+     */
+    bool push(const Key& key, const T& data) {
+        Tenant& tenant = tenantFor(key);
+        if (tenant.count >= tenant.depthLimit) return false;
+
+        Node* newNode = new Node(data);
+        if (tenant.rearNode == nullptr) {
+            tenant.frontNode = tenant.rearNode = newNode;
+        } else {
+            tenant.rearNode->next = newNode;
+            tenant.rearNode = newNode;
+        }
+        tenant.count++;
+        totalCount++;
+        if (!tenant.active) activate(tenant);
+        return true;
+    }
+
+    /**
+     * Removes the next item in deficit-round-robin order
+     * @param out Receives the item
+     * @param keyOut Receives the tenant key it belonged to
+     * @return false if every tenant is empty
+     */
+    bool pop(T& out, Key& keyOut) {
+        Tenant* tenant = activeHead;
+        if (tenant == nullptr) return false;
+        // Weights are >= 1, so at most one hop is needed to find credit
+        if (tenant->deficit == 0) tenant = advance(true);
+
+        Node* temp = tenant->frontNode;
+        out = temp->val;
+        keyOut = tenant->key;
+        tenant->frontNode = temp->next;
+        if (tenant->frontNode == nullptr) tenant->rearNode = nullptr;
+        delete temp;
+        tenant->count--;
+        tenant->deficit--;
+        totalCount--;
+
+        // An emptied tenant leaves the ring and forfeits its remaining credit
+        if (tenant->count == 0) advance(false);
+        return true;
+    }
+
+    size_t size() const { return totalCount; }
+
+    size_t tenantDepth(const Key& key) const {
+        auto it = tenants.find(key);
+        return it == tenants.end() ? 0 : it->second->count;
+    }
+
+    size_t tenantCount() const { return tenants.size(); }
+
+    ~FairQueue() = default;
+};
+
+/**
+ * Main function - noisy neighbour, weights, limits and scaling
+ */
+int main() {
+    cout << "=== Deficit-Round-Robin Fair Queue Demo ===" << endl;
+
+    cout << "\n--- Noisy Tenant vs Quiet Tenants ---" << endl;
+    FairQueue<string, int> fq;
+    for (int i = 0; i < 10000; i++) fq.push("noisy", i);
+    for (int i = 0; i < 3; i++) {
+        fq.push("alice", i);
+        fq.push("bob", i);
+    }
+    string tenant;
+    int job = 0;
+    cout << "First 9 dequeues:";
+    for (int i = 0; i < 9; i++) {
+        fq.pop(job, tenant);
+        cout << " " << tenant;
+    }
+    cout << endl;   // noisy alice bob noisy alice bob noisy alice bob
+
+    cout << "\n--- Weights (gold = 3, silver = 1) ---" << endl;
+    FairQueue<string, int> weighted;
+    weighted.setWeight("gold", 3);
+    for (int i = 0; i < 100; i++) {
+        weighted.push("gold", i);
+        weighted.push("silver", i);
+    }
+    map<string, int> served;
+    for (int i = 0; i < 80; i++) {
+        weighted.pop(job, tenant);
+        served[tenant]++;
+    }
+    cout << "After 80 dequeues: gold = " << served["gold"] << ", silver = " << served["silver"] << endl;  // 60 / 20
+
+    cout << "\n--- Depth Limit ---" << endl;
+    FairQueue<string, int> limited;
+    limited.setDepthLimit("noisy", 5);
+    int accepted = 0;
+    for (int i = 0; i < 10; i++) accepted += limited.push("noisy", i);
+    cout << "noisy accepted " << accepted << " of 10" << endl;                          // 5
+    cout << "alice accepted: " << (limited.push("alice", 1) ? "yes" : "no") << endl;    // yes
+
+    cout << "\n--- Scaling With 50000 Active Tenants ---" << endl;
+    FairQueue<int, int> big;
+    const int tenants = 50000, perTenant = 20;
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < perTenant; round++) {
+        for (int t = 0; t < tenants; t++) big.push(t, round);
+    }
+    auto mid = chrono::steady_clock::now();
+    int key = 0;
+    size_t drained = 0;
+    while (big.pop(job, key)) drained++;
+    auto end = chrono::steady_clock::now();
+    cout << "Pushed and drained " << drained << " items" << endl;
+    cout << "push: " << chrono::duration<double, nano>(mid - start).count() / drained << " ns/op | "
+         << "pop: " << chrono::duration<double, nano>(end - mid).count() / drained << " ns/op" << endl;
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+/*
+ * Linger-Time Batching Consumer
+ *
+ * Queue::pop hands out one item at a time, but disk and network writes cost
+ * roughly the same for one record as for a hundred. BatchingConsumer drains a
+ * queue into batches, in the style of a Kafka producer:
+ *
+ * - A batch is emitted as soon as it holds `target` items, or when `linger`
+ *   has passed since its first item arrived, whichever comes first
+ * - The queue hands over up to the remaining batch room in one lock
+ *   acquisition, not one lock per item
+ * - Adaptive target: the consumer tracks the arrival rate (EWMA) and sets
+ *   target = rate * linger, clamped to [minBatch, maxBatch]. At a trickle the
+ *   target falls to 1 and items go out immediately (no pointless lingering);
+ *   under load it grows so each write carries as much as the linger allows.
+ *
+ * Operations to support:
+ * - BlockingQueue::push(x) / close() / popBatch(out, max, deadline)
+ * - BatchingConsumer(queue, policy, sink): sink(vector<T>&) receives every batch
+ * - start() / stop(): Runs the consumer thread; stop() closes the queue and drains it
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+// ----------- Blocking Queue (LinkedList-based, thread safe) ------------
+template <typename T>
+class BlockingQueue {
+private:
+    struct Node {
+        T val;
+        Node* next;
+        explicit Node(const T& data) : val(data), next(nullptr) {}
+    };
+
+    Node* frontNode = nullptr;
+    Node* rearNode = nullptr;
+    size_t count = 0;
+    bool closed = false;
+    mutex lock;
+    condition_variable notEmpty;
+
+public:
+    BlockingQueue() = default;
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    void push(const T& data) {
+        Node* newNode = new Node(data);
+        {
+            lock_guard<mutex> guard(lock);
+            if (rearNode == nullptr) {
+                frontNode = rearNode = newNode;
+            } else {
+                rearNode->next = newNode;
+                rearNode = newNode;
+            }
+            count++;
+        }
+        notEmpty.notify_one();
+    }
+
+    /**
+     * Wakes the consumer; no more pushes are expected
+     */
+    void close() {
+        {
+            lock_guard<mutex> guard(lock);
+            closed = true;
+        }
+        notEmpty.notify_all();
+    }
+
+    /**
+     * Moves up to max items into out under a single lock acquisition
+     * @param deadline Waits at most until then for the first item
+     * @return Number of items taken (0 on timeout or when closed and empty)
+     */
+    size_t popBatch(vector<T>& out, size_t max, Clock::time_point deadline) {
+        unique_lock<mutex> guard(lock);
+        if (count == 0 && !closed) {
+            if (deadline == Clock::time_point::max()) {
+                notEmpty.wait(guard, [&] { return count > 0 || closed; });
+            } else {
+                notEmpty.wait_until(guard, deadline, [&] { return count > 0 || closed; });
+            }
+        }
+        size_t taken = 0;
+        while (taken < max && frontNode != nullptr) {
+            Node* temp = frontNode;
+            out.push_back(temp->val);
+            frontNode = frontNode->next;
+            delete temp;
+            taken++;
+        }
+        if (frontNode == nullptr) rearNode = nullptr;
+        count -= taken;
+        return taken;
+    }
+
+    bool drained() {
+        lock_guard<mutex> guard(lock);
+        return closed && count == 0;
+    }
+
+    ~BlockingQueue() {
+        while (frontNode != nullptr) {
+            Node* temp = frontNode;
+            frontNode = frontNode->next;
+            delete temp;
+        }
+    }
+};
+
+// ----------- Batching policy ------------
+struct BatchPolicy {
+    size_t minBatch = 1;
+    size_t maxBatch = 512;
+    chrono::microseconds linger{1000};   // Longest an item waits for company
+    bool adaptive = true;                // false: target is always maxBatch
+};
+
+struct BatchStats {
+    uint64_t batches = 0;
+    uint64_t items = 0;
+    uint64_t flushedBySize = 0;
+    uint64_t flushedByLinger = 0;
+};
+
+// ----------- Batching Consumer ------------
+template <typename T>
+class BatchingConsumer {
+private:
+    BlockingQueue<T>& queue;
+    BatchPolicy policy;
+    function<void(vector<T>&)> sink;
+    thread worker;
+
+    BatchStats stats;
+    atomic<size_t> target;      // Current batch-size goal
+    double ewmaRatePerUs = 0;   // Smoothed arrivals per microsecond
+    Clock::time_point lastFlush;
+
+    // Re-estimates the arrival rate from the last interval and retargets the batch size
+    void adapt(size_t items, Clock::time_point now) {
+        double elapsedUs = chrono::duration<double, micro>(now - lastFlush).count();
+        lastFlush = now;
+        if (!policy.adaptive || elapsedUs <= 0) return;
+        double rate = items / elapsedUs;
+        ewmaRatePerUs = ewmaRatePerUs == 0 ? rate : 0.8 * ewmaRatePerUs + 0.2 * rate;
+        double wanted = ewmaRatePerUs * (double)policy.linger.count();
+        size_t next = (size_t)wanted;
+        target.store(clamp(next, policy.minBatch, policy.maxBatch), memory_order_relaxed);
+    }
+
+    void run() {
+        vector<T> batch;
+        batch.reserve(policy.maxBatch);
+        lastFlush = Clock::now();
+        while (true) {
+            // Block for the first item of the next batch
+            if (queue.popBatch(batch, target.load(memory_order_relaxed), Clock::time_point::max()) == 0) {
+                if (queue.drained()) break;
+                continue;
+            }
+            size_t goal = target.load(memory_order_relaxed);
+            Clock::time_point deadline = Clock::now() + policy.linger;
+            // Top it up until it is full or the linger expires
+            while (batch.size() < goal && Clock::now() < deadline) {
+                if (queue.popBatch(batch, goal - batch.size(), deadline) == 0 && queue.drained()) break;
+            }
+
+            if (batch.size() >= goal) stats.flushedBySize++;
+            else stats.flushedByLinger++;
+            stats.batches++;
+            stats.items += batch.size();
+            sink(batch);
+            adapt(batch.size(), Clock::now());
+            batch.clear();
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * @param q Queue to drain
+     * @param p Batch size and linger limits
+     * @param s Called on the consumer thread with every batch
+     */
+    BatchingConsumer(BlockingQueue<T>& q, BatchPolicy p, function<void(vector<T>&)> s)
+        : queue(q), policy(p), sink(std::move(s)) {
+        if (policy.minBatch == 0) policy.minBatch = 1;
+        if (policy.maxBatch < policy.minBatch) policy.maxBatch = policy.minBatch;
+        target.store(policy.adaptive ? policy.minBatch : policy.maxBatch);
+    }
+
+    BatchingConsumer(const BatchingConsumer&) = delete;
+    BatchingConsumer& operator=(const BatchingConsumer&) = delete;
+
+    void start() {
+        worker = thread([this] { run(); });
+    }
+
+    /**
+     * Closes the queue, flushes what is left and joins the consumer thread
+     */
+    void stop() {
+        queue.close();
+        if (worker.joinable()) worker.join();
+    }
+
+    BatchStats getStats() const { return stats; }   // Call after stop()
+    size_t currentTarget() const { return target.load(memory_order_relaxed); }
+
+    ~BatchingConsumer() { stop(); }
+};
+
+// ----------- Demo helpers ------------
+
+struct Event {
+    int id;
+    Clock::time_point enqueuedAt;
+};
+
+// A write that costs 20us per call plus 50ns per record, like a small fsync'd append
+static void simulatedWrite(size_t records) {
+    auto until = Clock::now() + chrono::microseconds(20) + chrono::nanoseconds(50 * records);
+    while (Clock::now() < until) {
+    }
+}
+
+struct RunResult {
+    BatchStats stats;
+    double seconds;
+    double p50Us;
+    double p99Us;
+    size_t finalTarget;
+};
+
+/**
+ * Pushes `events` items, pausing gapUs between them (0 = as fast as possible)
+ */
+static RunResult runScenario(BatchPolicy policy, int events, int gapUs) {
+    BlockingQueue<Event> queue;
+    vector<double> latencies;
+    latencies.reserve(events);
+    BatchingConsumer<Event> consumer(queue, policy, [&latencies](vector<Event>& batch) {
+        simulatedWrite(batch.size());
+        Clock::time_point written = Clock::now();
+        for (const Event& e : batch) latencies.push_back(chrono::duration<double, micro>(written - e.enqueuedAt).count());
+    });
+
+    auto start = Clock::now();
+    consumer.start();
+    for (int i = 0; i < events; i++) {
+        queue.push(Event{i, Clock::now()});
+        if (gapUs > 0) this_thread::sleep_for(chrono::microseconds(gapUs));
+    }
+    size_t finalTarget = consumer.currentTarget();
+    consumer.stop();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    sort(latencies.begin(), latencies.end());
+    return RunResult{consumer.getStats(), seconds, latencies[latencies.size() / 2],
+                     latencies[latencies.size() * 99 / 100], finalTarget};
+}
+
+static void printResult(const char* label, const RunResult& r) {
+    cout << fixed << setprecision(1);
+    cout << label << ": " << r.stats.items << " items in " << r.stats.batches << " batches (avg "
+         << (double)r.stats.items / r.stats.batches << "), by size/linger = " << r.stats.flushedBySize << "/"
+         << r.stats.flushedByLinger << ", target " << r.finalTarget << endl;
+    cout << "    " << r.stats.items / r.seconds << " items/s, latency p50 " << r.p50Us << " us, p99 " << r.p99Us
+         << " us" << endl;
+}
+
+/**
+ * Main function - trickle vs flood, one-at-a-time vs fixed vs adaptive batching
+ */
+int main() {
+    cout << "=== Linger-Time Batching Consumer Demo ===" << endl;
+
+    BatchPolicy single;
+    single.maxBatch = 1;
+    single.adaptive = false;
+
+    BatchPolicy fixedBatch;
+    fixedBatch.maxBatch = 256;
+    fixedBatch.linger = chrono::microseconds(1000);
+    fixedBatch.adaptive = false;
+
+    BatchPolicy adaptive;
+    adaptive.maxBatch = 256;
+    adaptive.linger = chrono::microseconds(1000);
+
+    cout << "\n--- Flood: 200000 events as fast as possible ---" << endl;
+    printResult("one at a time", runScenario(single, 200000, 0));
+    printResult("fixed 256    ", runScenario(fixedBatch, 200000, 0));
+    printResult("adaptive     ", runScenario(adaptive, 200000, 0));
+
+    cout << "\n--- Trickle: 150 events, one every 2000 us ---" << endl;
+    printResult("fixed 256    ", runScenario(fixedBatch, 150, 2000));   // Every item lingers ~1 ms
+    printResult("adaptive     ", runScenario(adaptive, 150, 2000));     // Target drops to 1
+
+    return 0;
+}
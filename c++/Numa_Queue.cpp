@@ -0,0 +1,498 @@
+/*
+ * NUMA-Aware Queue
+ *
+ * On a multi-socket host a queue node written by a producer on socket 0 and
+ * read by a consumer on socket 1 costs a remote memory access for every item.
+ * NumaQueue keeps one sub-queue per NUMA node and keeps work close to the
+ * consumer that will read it:
+ *
+ * - Each node's sub-queue stores items in chunks whose pages are bound to
+ *   that node (mmap + mbind), so a consumer reading its own node's sub-queue
+ *   reads local memory; emptied chunks are recycled per node
+ * - push() goes to the caller's node, pushTo(node, x) routes explicitly
+ *   (e.g. to the node whose consumers own that key)
+ * - pop() drains the caller's node first and steals from other nodes only
+ *   when it is empty, nearest node first (by the kernel's distance table)
+ * - pinToNode / pinToCpu helpers fix producer and consumer threads in place,
+ *   so "the caller's node" stays the same
+ *
+ * Topology comes straight from sysfs (/sys/devices/system/node) and the
+ * kernel syscalls (getcpu, mbind, sched_setaffinity); libnuma is not needed.
+ * On a single-node machine, or where mbind is not permitted, it degrades to
+ * one ordinary chunked queue.
+ *
+ * Operations to support:
+ * - push(x) / pushTo(node, x)
+ * - pop(out) / popOn(node, out): Local first, then steal; false if all empty
+ * - NumaTopology::detect(), currentNode(), pinToNode(node), pinToCpu(cpu)
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <new>
+#include <cstdint>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+using namespace std;
+
+// ----------- Topology ------------
+struct NumaTopology {
+    vector<vector<int>> cpusOfNode;   // Index = node id
+    vector<int> nodeOfCpu;            // Index = cpu id, -1 if unknown
+    vector<vector<int>> distance;     // SLIT distances, 10 = local
+
+    size_t nodeCount() const { return cpusOfNode.size(); }
+
+    // Parses "0-3,8,10-11"
+    static vector<int> parseList(const string& text) {
+        vector<int> out;
+        stringstream in(text);
+        string part;
+        while (getline(in, part, ',')) {
+            if (part.empty() || part == "\n") continue;
+            size_t dash = part.find('-');
+            int first = stoi(part.substr(0, dash));
+            int last = dash == string::npos ? first : stoi(part.substr(dash + 1));
+            for (int i = first; i <= last; i++) out.push_back(i);
+        }
+        return out;
+    }
+
+    static string readFile(const string& path) {
+        ifstream in(path);
+        string text;
+        getline(in, text);
+        return text;
+    }
+
+    /**
+     * Reads the node layout from sysfs; falls back to one node holding every CPU
+     */
+    static NumaTopology detect() {
+        NumaTopology topo;
+        vector<int> nodes = parseList(readFile("/sys/devices/system/node/online"));
+        for (int node : nodes) {
+            string dir = "/sys/devices/system/node/node" + to_string(node);
+            if ((size_t)node >= topo.cpusOfNode.size()) topo.cpusOfNode.resize(node + 1);
+            topo.cpusOfNode[node] = parseList(readFile(dir + "/cpulist"));
+            if ((size_t)node >= topo.distance.size()) topo.distance.resize(node + 1);
+            stringstream in(readFile(dir + "/distance"));
+            int d;
+            while (in >> d) topo.distance[node].push_back(d);
+        }
+        if (topo.cpusOfNode.empty()) return single();
+        topo.indexCpus();
+        return topo;
+    }
+
+    /**
+     * One node, every CPU, for machines without sysfs NUMA information
+     */
+    static NumaTopology single() {
+        NumaTopology topo;
+        topo.cpusOfNode.resize(1);
+        for (unsigned c = 0; c < max(1u, thread::hardware_concurrency()); c++) topo.cpusOfNode[0].push_back((int)c);
+        topo.distance = {{10}};
+        topo.indexCpus();
+        return topo;
+    }
+
+    /**
+     * Pretends to have `nodes` nodes (CPUs dealt round-robin), for testing on small machines
+     */
+    static NumaTopology simulated(size_t nodes) {
+        NumaTopology topo;
+        topo.cpusOfNode.resize(nodes);
+        unsigned cpus = max(1u, thread::hardware_concurrency());
+        for (unsigned c = 0; c < max<unsigned>(cpus, nodes); c++) topo.cpusOfNode[c % nodes].push_back((int)(c % cpus));
+        topo.distance.assign(nodes, vector<int>(nodes, 20));
+        for (size_t n = 0; n < nodes; n++) topo.distance[n][n] = 10;
+        topo.indexCpus();
+        return topo;
+    }
+
+    /**
+     * Other nodes ordered nearest first: the order pop() steals in
+     */
+    vector<int> stealOrder(int node) const {
+        vector<int> order;
+        for (size_t n = 0; n < nodeCount(); n++) {
+            if ((int)n != node && !cpusOfNode[n].empty()) order.push_back((int)n);
+        }
+        auto dist = [&](int other) {
+            return (size_t)node < distance.size() && (size_t)other < distance[node].size() ? distance[node][other] : 20;
+        };
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return dist(a) < dist(b); });
+        return order;
+    }
+
+private:
+    void indexCpus() {
+        for (size_t n = 0; n < cpusOfNode.size(); n++) {
+            for (int cpu : cpusOfNode[n]) {
+                if ((size_t)cpu >= nodeOfCpu.size()) nodeOfCpu.resize(cpu + 1, -1);
+                if (nodeOfCpu[cpu] < 0) nodeOfCpu[cpu] = (int)n;
+            }
+        }
+    }
+};
+
+// ----------- Placement helpers ------------
+
+/**
+ * NUMA node of the CPU the caller is running on right now
+ */
+static int currentNode(const NumaTopology& topo) {
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+    if (topo.nodeCount() == 1) return 0;
+    if (cpu < topo.nodeOfCpu.size() && topo.nodeOfCpu[cpu] >= 0) return topo.nodeOfCpu[cpu];
+    return (int)node < (int)topo.nodeCount() ? (int)node : 0;
+}
+
+/**
+ * Restricts the calling thread to the CPUs of one node
+ * @return false if the node has no CPUs or the kernel refused
+ */
+static bool pinToNode(const NumaTopology& topo, int node) {
+    if (node < 0 || (size_t)node >= topo.nodeCount() || topo.cpusOfNode[node].empty()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : topo.cpusOfNode[node]) CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+/**
+ * Restricts the calling thread to a single CPU
+ */
+static bool pinToCpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+/**
+ * Maps `bytes` of anonymous memory and asks the kernel to place it on `node`
+ * (preferred, so allocation still succeeds when the node is full)
+ * @param bound Set to false when mbind was refused (the memory is still usable)
+ * @return The mapping, or nullptr if mmap failed
+ */
+static void* allocOnNode(size_t bytes, int node, bool& bound) {
+    void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return nullptr;
+    unsigned long mask = 0;
+    bound = false;
+    if (node >= 0 && node < (int)(8 * sizeof(mask))) {
+        mask = 1UL << node;
+        bound = syscall(SYS_mbind, mem, bytes, MPOL_PREFERRED, &mask, 8 * sizeof(mask) + 1, 0) == 0;
+    }
+    return mem;
+}
+
+/**
+ * Node that physically holds the page at `addr` (after it has been touched), -1 if unknown
+ */
+static int nodeOfAddress(void* addr) {
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, addr, MPOL_F_NODE | MPOL_F_ADDR) != 0) return -1;
+    return node;
+}
+
+// ----------- NUMA-aware queue ------------
+struct NumaQueueStats {
+    uint64_t localPops = 0;
+    uint64_t stolenPops = 0;
+    uint64_t chunksMapped = 0;
+    uint64_t chunksUnbound = 0;   // mbind refused; placement left to first touch
+};
+
+template <typename T>
+class NumaQueue {
+private:
+    static const size_t CHUNK_BYTES = 64 * 1024;
+
+    // ----------- Chunk (Single Linked List Node holding a run of items) ------------
+    struct Chunk {
+        Chunk* next = nullptr;
+        size_t head = 0;   // Next slot to pop
+        size_t tail = 0;   // Next slot to push
+    };
+    static const size_t SLOTS_OFFSET = 64;   // Items start on the chunk's second cache line
+    static const size_t CHUNK_ITEMS = (CHUNK_BYTES - SLOTS_OFFSET) / sizeof(T);
+    static_assert(sizeof(Chunk) <= SLOTS_OFFSET && alignof(T) <= SLOTS_OFFSET, "chunk header layout");
+    static_assert(CHUNK_ITEMS >= 16, "element type too large for a chunk");
+
+    static T* slots(Chunk* chunk) {
+        return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(chunk) + SLOTS_OFFSET);
+    }
+
+    struct alignas(64) SubQueue {
+        mutex lock;
+        int node = 0;
+        Chunk* frontChunk = nullptr;
+        Chunk* rearChunk = nullptr;
+        Chunk* freeChunks = nullptr;   // Emptied chunks, still bound to this node
+        size_t count = 0;
+        atomic<size_t> approxCount{0}; // Read without the lock by stealers
+        uint64_t chunksMapped = 0;
+        uint64_t chunksUnbound = 0;
+    };
+
+    NumaTopology topo;
+    unique_ptr<SubQueue[]> subQueues;
+    vector<vector<int>> stealOrders;
+    atomic<uint64_t> localPops{0};
+    atomic<uint64_t> stolenPops{0};
+
+    Chunk* takeChunk(SubQueue& q) {
+        Chunk* chunk = q.freeChunks;
+        if (chunk != nullptr) {
+            q.freeChunks = chunk->next;
+        } else {
+            bool bound = false;
+            void* mem = allocOnNode(CHUNK_BYTES, q.node, bound);
+            if (mem == nullptr) throw bad_alloc();
+            chunk = static_cast<Chunk*>(mem);
+            q.chunksMapped++;
+            if (!bound) q.chunksUnbound++;
+        }
+        chunk->next = nullptr;
+        chunk->head = chunk->tail = 0;
+        return chunk;
+    }
+
+    void pushLocked(SubQueue& q, const T& data) {
+        if (q.rearChunk == nullptr) {
+            q.frontChunk = q.rearChunk = takeChunk(q);
+        } else if (q.rearChunk->tail == CHUNK_ITEMS) {
+            Chunk* fresh = takeChunk(q);
+            q.rearChunk->next = fresh;
+            q.rearChunk = fresh;
+        }
+        new (&slots(q.rearChunk)[q.rearChunk->tail++]) T(data);
+        q.count++;
+        q.approxCount.store(q.count, memory_order_relaxed);
+    }
+
+    bool popLocked(SubQueue& q, T& out) {
+        if (q.count == 0) return false;
+        Chunk* chunk = q.frontChunk;
+        T* item = &slots(chunk)[chunk->head++];
+        out = std::move(*item);
+        item->~T();
+        q.count--;
+        q.approxCount.store(q.count, memory_order_relaxed);
+        if (chunk->head == chunk->tail) {
+            if (chunk == q.rearChunk) {
+                chunk->head = chunk->tail = 0;   // Reuse in place
+            } else {
+                q.frontChunk = chunk->next;
+                chunk->next = q.freeChunks;
+                q.freeChunks = chunk;
+            }
+        }
+        return true;
+    }
+
+    static void unmapChain(Chunk* chunk) {
+        while (chunk != nullptr) {
+            Chunk* next = chunk->next;
+            munmap(chunk, CHUNK_BYTES);
+            chunk = next;
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * @param topology Node layout; NumaTopology::detect() for the real machine
+     */
+    explicit NumaQueue(NumaTopology topology = NumaTopology::detect()) : topo(std::move(topology)) {
+        subQueues.reset(new SubQueue[topo.nodeCount()]);
+        for (size_t n = 0; n < topo.nodeCount(); n++) {
+            subQueues[n].node = (int)n;
+            stealOrders.push_back(topo.stealOrder((int)n));
+        }
+    }
+
+    NumaQueue(const NumaQueue&) = delete;
+    NumaQueue& operator=(const NumaQueue&) = delete;
+
+    const NumaTopology& topology() const { return topo; }
+
+    /**
+     * Enqueues on the caller's node
+     */
+    void push(const T& data) {
+        pushTo(currentNode(topo), data);
+    }
+
+    /**
+     * Enqueues on a given node's sub-queue, e.g. the node of the consumer that owns the key
+     */
+    void pushTo(int node, const T& data) {
+        SubQueue& q = subQueues[(size_t)node % topo.nodeCount()];
+        lock_guard<mutex> guard(q.lock);
+        pushLocked(q, data);
+    }
+
+    /**
+     * Dequeues on the caller's node, stealing only when that node is empty
+     */
+    bool pop(T& out) {
+        return popOn(currentNode(topo), out);
+    }
+
+    /**
+     * Dequeues from `node`'s sub-queue, otherwise steals from the nearest
+     * non-empty node; empty-looking nodes are skipped without taking their lock
+     * @return false if every sub-queue was empty
+     */
+    bool popOn(int node, T& out) {
+        SubQueue& local = subQueues[(size_t)node % topo.nodeCount()];
+        {
+            lock_guard<mutex> guard(local.lock);
+            if (popLocked(local, out)) {
+                localPops.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        for (int victim : stealOrders[(size_t)node % topo.nodeCount()]) {
+            SubQueue& q = subQueues[victim];
+            if (q.approxCount.load(memory_order_relaxed) == 0) continue;
+            lock_guard<mutex> guard(q.lock);
+            if (popLocked(q, out)) {
+                stolenPops.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Node holding the pages of `node`'s current rear chunk (-1 if none or unknown)
+     */
+    int placementOf(int node) {
+        SubQueue& q = subQueues[(size_t)node % topo.nodeCount()];
+        lock_guard<mutex> guard(q.lock);
+        return q.rearChunk == nullptr ? -1 : nodeOfAddress(q.rearChunk);
+    }
+
+    NumaQueueStats getStats() {
+        NumaQueueStats s;
+        s.localPops = localPops.load(memory_order_relaxed);
+        s.stolenPops = stolenPops.load(memory_order_relaxed);
+        for (size_t n = 0; n < topo.nodeCount(); n++) {
+            lock_guard<mutex> guard(subQueues[n].lock);
+            s.chunksMapped += subQueues[n].chunksMapped;
+            s.chunksUnbound += subQueues[n].chunksUnbound;
+        }
+        return s;
+    }
+
+    ~NumaQueue() {
+        T discard;
+        for (size_t n = 0; n < topo.nodeCount(); n++) {
+            SubQueue& q = subQueues[n];
+            while (popLocked(q, discard)) {
+            }
+            unmapChain(q.frontChunk);
+            unmapChain(q.freeChunks);
+        }
+    }
+};
+
+// ----------- Demo ------------
+
+static void printTopology(const NumaTopology& topo) {
+    for (size_t n = 0; n < topo.nodeCount(); n++) {
+        cout << "node " << n << ": " << topo.cpusOfNode[n].size() << " cpu(s), steal order:";
+        for (int other : topo.stealOrder((int)n)) cout << " " << other;
+        if (topo.stealOrder((int)n).empty()) cout << " (none)";
+        cout << endl;
+    }
+}
+
+/**
+ * Main function - topology, local-first popping with stealing, pinned threads
+ */
+int main() {
+    cout << "=== NUMA-Aware Queue Demo ===" << endl;
+
+    cout << "\n--- Detected Topology ---" << endl;
+    NumaTopology machine = NumaTopology::detect();
+    printTopology(machine);
+    cout << "Caller runs on node " << currentNode(machine) << endl;
+
+    cout << "\n--- Chunk Placement ---" << endl;
+    {
+        NumaQueue<long> q(machine);
+        for (long i = 0; i < 100000; i++) q.pushTo(0, i);
+        NumaQueueStats s = q.getStats();
+        cout << "Chunks mapped: " << s.chunksMapped << ", mbind refused: " << s.chunksUnbound << endl;
+        cout << "Node 0's rear chunk lives on node " << q.placementOf(0) << endl;   // Should print 0
+    }
+
+    cout << "\n--- Local First, Then Steal (simulated 2 nodes) ---" << endl;
+    {
+        NumaQueue<int> q(NumaTopology::simulated(2));
+        for (int i = 0; i < 3; i++) q.pushTo(0, 100 + i);
+        for (int i = 0; i < 2; i++) q.pushTo(1, 200 + i);
+        int value = 0;
+        cout << "Node 1 consumer pops:";
+        while (q.popOn(1, value)) cout << " " << value;   // 200 201, then steals 100 101 102
+        cout << endl;
+        NumaQueueStats s = q.getStats();
+        cout << "Local pops: " << s.localPops << ", stolen: " << s.stolenPops << endl;   // 2, 3
+    }
+
+    cout << "\n--- Pinned Producers and Consumers (simulated 2 nodes) ---" << endl;
+    {
+        NumaQueue<int> q(NumaTopology::simulated(2));
+        const int perProducer = 200000;
+        atomic<long long> sum{0};
+        atomic<int> consumed{0};
+        vector<thread> threads;
+        for (int node = 0; node < 2; node++) {
+            threads.emplace_back([&, node] {
+                pinToNode(q.topology(), node);
+                for (int i = 0; i < perProducer; i++) q.pushTo(node, i);
+            });
+            threads.emplace_back([&, node] {
+                pinToNode(q.topology(), node);
+                int value = 0;
+                long long local = 0;
+                while (consumed.load() < 2 * perProducer) {
+                    if (q.popOn(node, value)) {
+                        local += value;
+                        consumed++;
+                    } else {
+                        this_thread::yield();
+                    }
+                }
+                sum += local;
+            });
+        }
+        for (auto& t : threads) t.join();
+        NumaQueueStats s = q.getStats();
+        long long expected = 2LL * perProducer * (perProducer - 1) / 2;
+        cout << "Sum " << (sum == expected ? "ok" : "MISMATCH") << ", local pops " << s.localPops << ", stolen "
+             << s.stolenPops << endl;
+    }
+
+    cout << "\nPinning helpers: pinToCpu(0) " << (pinToCpu(0) ? "ok" : "refused") << endl;
+    return 0;
+}
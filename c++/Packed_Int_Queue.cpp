@@ -0,0 +1,544 @@
+/*
+ * Packed Integer Queue (bit-packed blocks of small IDs)
+ *
+ * The linked-list Queue spends a 16-byte node on every 4-byte int, so a
+ * billion queued IDs need 16 GB. PackedIntQueue stores unsigned 32-bit values
+ * in blocks of 128, each packed at the smallest bit width that holds it:
+ *
+ * - The producer fills a 128-value staging block; when it is full the block is
+ *   sealed with whichever encoding needs fewer bits:
+ *     FOR   frame of reference: value - min(block)
+ *     D4    zigzag(value - value four positions earlier), good for sorted or
+ *           slowly drifting IDs (the four-apart delta keeps 4 SIMD lanes
+ *           independent, so decoding is one vector add per step)
+ *   A block costs an 8-byte header plus 16 * width bytes; a block of equal
+ *   values has width 0 and no payload at all.
+ * - Values are packed in a 4-lane vertical layout: lane j holds values j, j+4,
+ *   j+8 ..., so packing and unpacking move 4 values per SSE2 instruction
+ *   (a scalar path produces the identical format when SSE2 is unavailable)
+ * - Sealed blocks are appended to 64 KB chunks kept in a linked list; the
+ *   consumer unpacks one block at a time, frees a chunk as soon as it has been
+ *   read, and reads the staging block directly when nothing is sealed yet
+ * - pushBatch / popBatch pack from and unpack into the caller's buffer
+ *   directly when they are block aligned
+ *
+ * Operations to support:
+ * - push(x) / pushBatch(values, n)
+ * - pop(out) / popBatch(out, n): FIFO, false / short count when empty
+ * - size(), memoryBytes()
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#if defined(__SSE2__) && !defined(PACKED_QUEUE_SCALAR)
+#include <emmintrin.h>
+#define PACKED_QUEUE_SSE2 1
+#endif
+
+using namespace std;
+
+// ----------- Block codec ------------
+namespace packing {
+
+const size_t BLOCK = 128;   // Values per block: 4 lanes x 32
+
+enum Mode : uint8_t { FOR = 0, D4 = 1 };
+
+struct BlockHeader {
+    uint32_t base;   // FOR: block minimum; D4: first value
+    uint8_t width;   // Bits per packed value, 0..32
+    uint8_t mode;
+    uint16_t reserved;
+};
+
+inline int bitWidth(uint32_t x) {
+    return x == 0 ? 0 : 32 - __builtin_clz(x);
+}
+
+inline size_t payloadWords(int width) {
+    return 4 * (size_t)width;
+}
+
+inline uint32_t zigzag(uint32_t delta) {
+    return (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+}
+
+inline uint32_t unzigzag(uint32_t z) {
+    return (z >> 1) ^ (0u - (z & 1));
+}
+
+/**
+ * Packs 128 already-transformed values, each < 2^width, into 4 * width words
+ */
+inline void packLanes(const uint32_t* in, int width, uint32_t* out) {
+    if (width == 0) return;
+#ifdef PACKED_QUEUE_SSE2
+    __m128i acc = _mm_setzero_si128();
+    int shift = 0;
+    for (size_t k = 0; k < 32; k++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + 4 * k));
+        acc = _mm_or_si128(acc, _mm_sll_epi32(v, _mm_cvtsi32_si128(shift)));
+        shift += width;
+        if (shift >= 32) {
+            _mm_storeu_si128((__m128i*)out, acc);
+            out += 4;
+            shift -= 32;
+            acc = shift > 0 ? _mm_srl_epi32(v, _mm_cvtsi32_si128(width - shift)) : _mm_setzero_si128();
+        }
+    }
+#else
+    for (size_t lane = 0; lane < 4; lane++) {
+        uint64_t acc = 0;
+        int bits = 0;
+        size_t word = 0;
+        for (size_t k = 0; k < 32; k++) {
+            acc |= (uint64_t)in[4 * k + lane] << bits;
+            bits += width;
+            if (bits >= 32) {
+                out[4 * word++ + lane] = (uint32_t)acc;
+                acc >>= 32;
+                bits -= 32;
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * Unpacks a block and undoes its transform, writing 128 values to out
+ */
+inline void unpackBlock(const BlockHeader& header, const uint32_t* in, uint32_t* out) {
+    int width = header.width;
+    if (width == 0) {
+        // FOR: all equal to base; D4: every delta is zero, so also all equal to base
+        for (size_t i = 0; i < BLOCK; i++) out[i] = header.base;
+        return;
+    }
+#ifdef PACKED_QUEUE_SSE2
+    const __m128i mask = _mm_set1_epi32(width == 32 ? -1 : (int)((1u << width) - 1));
+    const __m128i one = _mm_set1_epi32(1);
+    __m128i prev = _mm_set1_epi32((int)header.base);
+    __m128i cur = _mm_loadu_si128((const __m128i*)in);
+    int shift = 0;
+    for (size_t k = 0; k < 32; k++) {
+        __m128i v = _mm_srl_epi32(cur, _mm_cvtsi32_si128(shift));
+        shift += width;
+        if (shift >= 32) {
+            shift -= 32;
+            in += 4;
+            if (k < 31) {
+                cur = _mm_loadu_si128((const __m128i*)in);
+                if (shift > 0) v = _mm_or_si128(v, _mm_sll_epi32(cur, _mm_cvtsi32_si128(width - shift)));
+            }
+        }
+        v = _mm_and_si128(v, mask);
+        if (header.mode == D4) {
+            __m128i sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, one));
+            prev = _mm_add_epi32(prev, _mm_xor_si128(_mm_srli_epi32(v, 1), sign));
+            v = prev;
+        } else {
+            v = _mm_add_epi32(v, prev);   // prev holds the broadcast base for FOR
+        }
+        _mm_storeu_si128((__m128i*)(out + 4 * k), v);
+    }
+#else
+    uint64_t mask = width == 32 ? 0xFFFFFFFFULL : (1ULL << width) - 1;
+    for (size_t lane = 0; lane < 4; lane++) {
+        uint64_t acc = 0;
+        int bits = 0;
+        size_t word = 0;
+        uint32_t prev = header.base;
+        for (size_t k = 0; k < 32; k++) {
+            if (bits < width) {
+                acc |= (uint64_t)in[4 * word++ + lane] << bits;
+                bits += 32;
+            }
+            uint32_t v = (uint32_t)(acc & mask);
+            acc >>= width;
+            bits -= width;
+            if (header.mode == D4) {
+                prev += unzigzag(v);
+                v = prev;
+            } else {
+                v += header.base;
+            }
+            out[4 * k + lane] = v;
+        }
+    }
+#endif
+}
+
+/**
+ * Chooses FOR or D4 for 128 values, transforms them into scratch and fills the header
+ */
+inline void encodeBlock(const uint32_t* values, BlockHeader& header, uint32_t* scratch) {
+    header.reserved = 0;
+#ifdef PACKED_QUEUE_SSE2
+    // Unsigned min via signed compare on sign-flipped lanes (SSE2 has no pminud)
+    const __m128i flip = _mm_set1_epi32((int)0x80000000u);
+    __m128i lowFlipped = _mm_xor_si128(_mm_loadu_si128((const __m128i*)values), flip);
+    __m128i prev = _mm_set1_epi32((int)values[0]);
+    __m128i d4Or = _mm_setzero_si128();
+    for (size_t k = 0; k < 32; k++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(values + 4 * k));
+        __m128i vf = _mm_xor_si128(v, flip);
+        __m128i less = _mm_cmplt_epi32(vf, lowFlipped);
+        lowFlipped = _mm_or_si128(_mm_and_si128(less, vf), _mm_andnot_si128(less, lowFlipped));
+        __m128i delta = _mm_sub_epi32(v, prev);
+        __m128i z = _mm_xor_si128(_mm_slli_epi32(delta, 1), _mm_srai_epi32(delta, 31));
+        _mm_storeu_si128((__m128i*)(scratch + 4 * k), z);   // Kept in case D4 wins
+        d4Or = _mm_or_si128(d4Or, z);
+        prev = v;
+    }
+    uint32_t lanes[4], ors[4];
+    _mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(lowFlipped, flip));
+    _mm_storeu_si128((__m128i*)ors, d4Or);
+    uint32_t low = min(min(lanes[0], lanes[1]), min(lanes[2], lanes[3]));
+    uint32_t d4Bits = ors[0] | ors[1] | ors[2] | ors[3];
+
+    __m128i forOr = _mm_setzero_si128();
+    __m128i base = _mm_set1_epi32((int)low);
+    for (size_t k = 0; k < 32; k++) {
+        forOr = _mm_or_si128(forOr, _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(values + 4 * k)), base));
+    }
+    _mm_storeu_si128((__m128i*)ors, forOr);
+    uint32_t forBits = ors[0] | ors[1] | ors[2] | ors[3];
+
+    if (bitWidth(d4Bits) < bitWidth(forBits)) {
+        header.mode = D4;
+        header.base = values[0];
+        header.width = (uint8_t)bitWidth(d4Bits);
+        return;   // scratch already holds the zigzagged deltas
+    }
+    header.mode = FOR;   // Ties go to FOR: decoding it has no carried dependency
+    header.base = low;
+    header.width = (uint8_t)bitWidth(forBits);
+    for (size_t k = 0; k < 32; k++) {
+        __m128i v = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(values + 4 * k)), base);
+        _mm_storeu_si128((__m128i*)(scratch + 4 * k), v);
+    }
+#else
+    uint32_t low = values[0];
+    for (size_t i = 1; i < BLOCK; i++) low = min(low, values[i]);
+    uint32_t forBits = 0, d4Bits = 0;
+    for (size_t i = 0; i < BLOCK; i++) {
+        forBits |= values[i] - low;
+        d4Bits |= zigzag(values[i] - (i < 4 ? values[0] : values[i - 4]));
+    }
+
+    if (bitWidth(d4Bits) < bitWidth(forBits)) {
+        header.mode = D4;
+        header.base = values[0];
+        header.width = (uint8_t)bitWidth(d4Bits);
+        for (size_t i = 0; i < BLOCK; i++) scratch[i] = zigzag(values[i] - (i < 4 ? values[0] : values[i - 4]));
+    } else {
+        header.mode = FOR;   // Ties go to FOR: decoding it has no carried dependency
+        header.base = low;
+        header.width = (uint8_t)bitWidth(forBits);
+        for (size_t i = 0; i < BLOCK; i++) scratch[i] = values[i] - low;
+    }
+#endif
+}
+
+}  // namespace packing
+
+// ----------- Packed Integer Queue ------------
+class PackedIntQueue {
+private:
+    static const size_t CHUNK_BYTES = 64 * 1024;
+
+    // ----------- Chunk (Single Linked List Node holding packed blocks) ------------
+    struct Chunk {
+        Chunk* next = nullptr;
+        size_t used = 0;      // Bytes written by the producer
+        size_t readPos = 0;   // Bytes consumed
+        alignas(16) unsigned char data[CHUNK_BYTES];
+    };
+
+    static const size_t MAX_BLOCK_BYTES = sizeof(packing::BlockHeader) + 4 * 32 * sizeof(uint32_t);
+
+    Chunk* frontChunk = nullptr;   // Consumer reads sealed blocks here
+    Chunk* rearChunk = nullptr;    // Producer appends sealed blocks here
+    Chunk* spareChunk = nullptr;   // One emptied chunk kept to avoid allocator churn
+    size_t chunkCount = 0;
+    size_t sealedBlocks = 0;
+    size_t count = 0;
+
+    uint32_t staging[packing::BLOCK];   // Producer side, not yet sealed
+    size_t stagingLen = 0;
+    uint32_t readBuf[packing::BLOCK];   // Consumer side, already unpacked
+    size_t readPos = 0;
+    size_t readLen = 0;
+    uint32_t scratch[packing::BLOCK];
+
+    Chunk* newChunk() {
+        Chunk* chunk = spareChunk;
+        if (chunk != nullptr) {
+            spareChunk = nullptr;
+            chunk->next = nullptr;
+            chunk->used = chunk->readPos = 0;
+        } else {
+            chunk = new Chunk();
+            chunkCount++;
+        }
+        return chunk;
+    }
+
+    void releaseChunk(Chunk* chunk) {
+        if (spareChunk == nullptr) {
+            spareChunk = chunk;
+        } else {
+            delete chunk;
+            chunkCount--;
+        }
+    }
+
+    // Encodes 128 values and appends the block to the rear chunk
+    void sealBlock(const uint32_t* values) {
+        packing::BlockHeader header;
+        packing::encodeBlock(values, header, scratch);
+        size_t bytes = sizeof(header) + packing::payloadWords(header.width) * sizeof(uint32_t);
+
+        if (rearChunk == nullptr) {
+            frontChunk = rearChunk = newChunk();
+        } else if (CHUNK_BYTES - rearChunk->used < bytes) {
+            Chunk* fresh = newChunk();
+            rearChunk->next = fresh;
+            rearChunk = fresh;
+        }
+        unsigned char* at = rearChunk->data + rearChunk->used;
+        memcpy(at, &header, sizeof(header));
+        packing::packLanes(scratch, header.width, reinterpret_cast<uint32_t*>(at + sizeof(header)));
+        rearChunk->used += bytes;
+        sealedBlocks++;
+    }
+
+    // Unpacks the oldest sealed block into out (128 values)
+    void unsealBlock(uint32_t* out) {
+        if (frontChunk->readPos == frontChunk->used) {
+            Chunk* done = frontChunk;
+            frontChunk = frontChunk->next;
+            releaseChunk(done);
+        }
+        unsigned char* at = frontChunk->data + frontChunk->readPos;
+        packing::BlockHeader header;
+        memcpy(&header, at, sizeof(header));
+        packing::unpackBlock(header, reinterpret_cast<const uint32_t*>(at + sizeof(header)), out);
+        frontChunk->readPos += sizeof(header) + packing::payloadWords(header.width) * sizeof(uint32_t);
+        sealedBlocks--;
+        if (sealedBlocks == 0) {
+            // Everything sealed has been read: rewind the rear chunk instead of growing it
+            for (Chunk* c = frontChunk; c != nullptr;) {
+                Chunk* next = c->next;
+                if (c != rearChunk) releaseChunk(c);
+                c = next;
+            }
+            frontChunk = rearChunk;
+            rearChunk->used = rearChunk->readPos = 0;
+        }
+    }
+
+    // Makes readBuf non-empty: next sealed block, else whatever is staged
+    bool refill() {
+        readPos = 0;
+        if (sealedBlocks > 0) {
+            unsealBlock(readBuf);
+            readLen = packing::BLOCK;
+            return true;
+        }
+        if (stagingLen == 0) {
+            readLen = 0;
+            return false;
+        }
+        memcpy(readBuf, staging, stagingLen * sizeof(uint32_t));
+        readLen = stagingLen;
+        stagingLen = 0;
+        return true;
+    }
+
+public:
+    PackedIntQueue() = default;
+    PackedIntQueue(const PackedIntQueue&) = delete;
+    PackedIntQueue& operator=(const PackedIntQueue&) = delete;
+
+    void push(uint32_t value) {
+        staging[stagingLen++] = value;
+        if (stagingLen == packing::BLOCK) {
+            sealBlock(staging);
+            stagingLen = 0;
+        }
+        count++;
+    }
+
+    /**
+     * Pushes n values; full blocks are packed straight from the caller's buffer
+     */
+    void pushBatch(const uint32_t* values, size_t n) {
+        count += n;
+        while (n > 0) {
+            if (stagingLen == 0 && n >= packing::BLOCK) {
+                sealBlock(values);
+                values += packing::BLOCK;
+                n -= packing::BLOCK;
+                continue;
+            }
+            size_t take = min(n, packing::BLOCK - stagingLen);
+            memcpy(staging + stagingLen, values, take * sizeof(uint32_t));
+            stagingLen += take;
+            values += take;
+            n -= take;
+            if (stagingLen == packing::BLOCK) {
+                sealBlock(staging);
+                stagingLen = 0;
+            }
+        }
+    }
+
+    /**
+     * Removes the front value
+     * @return false if the queue is empty
+     */
+    bool pop(uint32_t& out) {
+        if (readPos == readLen && !refill()) return false;
+        out = readBuf[readPos++];
+        count--;
+        return true;
+    }
+
+    /**
+     * Removes up to n values in FIFO order; whole blocks unpack straight into out
+     * @return Number of values written
+     */
+    size_t popBatch(uint32_t* out, size_t n) {
+        size_t got = 0;
+        while (got < n) {
+            if (readPos < readLen) {
+                size_t take = min(n - got, readLen - readPos);
+                memcpy(out + got, readBuf + readPos, take * sizeof(uint32_t));
+                readPos += take;
+                got += take;
+            } else if (sealedBlocks > 0 && n - got >= packing::BLOCK) {
+                unsealBlock(out + got);
+                got += packing::BLOCK;
+            } else if (!refill()) {
+                break;
+            }
+        }
+        count -= got;
+        return got;
+    }
+
+    size_t size() const { return count; }
+
+    // Heap footprint of the chunks plus the queue object itself
+    size_t memoryBytes() const {
+        return chunkCount * sizeof(Chunk) + sizeof(*this);
+    }
+
+    ~PackedIntQueue() {
+        while (frontChunk != nullptr) {
+            Chunk* temp = frontChunk;
+            frontChunk = frontChunk->next;
+            delete temp;
+        }
+        delete spareChunk;
+    }
+};
+
+// ----------- Benchmark helpers ------------
+
+// Prevents the optimizer from discarding popped values
+static volatile long long benchmarkSink = 0;
+
+struct Workload {
+    const char* name;
+    vector<uint32_t> values;
+};
+
+static uint64_t nextRandom(uint64_t& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+/**
+ * Pushes the workload `repeat` times in 4096-value batches, then pops it all back
+ */
+static void measure(const Workload& w, int repeat) {
+    PackedIntQueue q;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < w.values.size(); i += 4096) {
+            q.pushBatch(w.values.data() + i, min<size_t>(4096, w.values.size() - i));
+        }
+    }
+    double pushS = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t total = q.size();
+    double bytesPerValue = (double)q.memoryBytes() / total;
+
+    vector<uint32_t> out(4096);
+    bool intact = true;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t i = 0; i < w.values.size(); i += 4096) {
+            size_t got = q.popBatch(out.data(), 4096);
+            intact = intact && memcmp(out.data(), w.values.data() + i, got * sizeof(uint32_t)) == 0;
+        }
+    }
+    double popS = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    benchmarkSink += out[0];
+
+    cout << left << setw(24) << w.name << right << fixed << setprecision(2) << setw(6) << bytesPerValue
+         << " B/value, push " << setw(6) << setprecision(0) << total / pushS / 1e6 << " M/s, pop " << setw(6)
+         << total / popS / 1e6 << " M/s, round trip " << (intact ? "ok" : "CORRUPT") << endl;
+}
+
+/**
+ * Main function - FIFO behaviour, per-block encodings, memory and throughput
+ */
+int main() {
+    cout << "=== Packed Integer Queue Demo ===" << endl;
+
+    cout << "\n--- FIFO Across Staging and Sealed Blocks ---" << endl;
+    PackedIntQueue q;
+    for (uint32_t i = 0; i < 300; i++) q.push(1000 + i);
+    uint32_t value = 0;
+    q.pop(value);
+    cout << "Pop: " << value << endl;   // Should print 1000
+    for (int i = 0; i < 200; i++) q.pop(value);
+    cout << "Pop after 200 more: " << value << endl;   // Should print 1200
+    q.push(7);
+    uint32_t rest[128];
+    size_t got = q.popBatch(rest, 128);
+    cout << "popBatch got " << got << ", last " << rest[got - 1] << ", size now " << q.size() << endl;   // 100, 7, 0
+
+    cout << "\n--- Memory and Throughput (" <<
+#ifdef PACKED_QUEUE_SSE2
+        "SSE2"
+#else
+        "scalar"
+#endif
+         << ", 100M values each) ---" << endl;
+    const size_t n = 1 << 22;
+    uint64_t state = 42;
+    Workload sortedIds{"sorted IDs (D4)", vector<uint32_t>(n)};
+    Workload smallIds{"random IDs < 2^20 (FOR)", vector<uint32_t>(n)};
+    Workload clustered{"clustered IDs", vector<uint32_t>(n)};
+    Workload fullRange{"random 32-bit", vector<uint32_t>(n)};
+    uint32_t id = 0;
+    for (size_t i = 0; i < n; i++) {
+        id += 1 + nextRandom(state) % 8;
+        sortedIds.values[i] = id;
+        smallIds.values[i] = nextRandom(state) % (1 << 20);
+        clustered.values[i] = 5000000 + (uint32_t)(i / 100000) * 1000 + nextRandom(state) % 256;
+        fullRange.values[i] = (uint32_t)(nextRandom(state) ^ (nextRandom(state) << 16));
+    }
+    for (const Workload* w : {&sortedIds, &smallIds, &clustered, &fullRange}) measure(*w, 24);
+
+    cout << "(linked-list Queue: 16 B/value; std::deque<uint32_t>: ~4 B/value)" << endl;
+    return 0;
+}
@@ -0,0 +1,698 @@
+/*
+ * Policy-Based Queue
+ *
+ * Instead of one class per queue flavour, Queue<T, Storage, Sync, Wait> is
+ * assembled at compile time from three independent policies:
+ *
+ * - Storage: LinkedStorage        one node per element (as in Queue_using_LinkedLIst.cpp)
+ *            UnrolledStorage<B>   linked blocks of B elements
+ *            RingStorage<N>       bounded ring of N elements
+ * - Sync:    NoSync               single thread, plain fields
+ *            SpscSync             one producer + one consumer thread, lock-free
+ *            MpscSync             many producers (spinlock) + one consumer (lock-free)
+ *            MpmcSync             spinlock per side (two-lock queue)
+ * - Wait:    SpinWait / YieldWait / FutexWait  used by blocking push()/pop()
+ *            AdaptiveWait         backoff spin, then yield, then futex park, with
+ *                                 the spin budget learned from past wait times
+ *
+ * How they compose: every storage is written so that it is safe for exactly one
+ * producer and one consumer when its fields are atomics, and is plain data when
+ * they are not. The Sync policy supplies the field type (Cell) and, for MPSC /
+ * MPMC, a lock that serializes each side, which reduces the multi-thread case to
+ * the SPSC case. Nothing is virtual; an unused guarantee costs nothing, and
+ * switching configuration is a one-line change of a type alias.
+ *
+ * Design Patterns Used:
+ * - Policy-Based Design (compile-time Strategy)
+ */
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+
+using namespace std;
+
+// ============================================================================
+// Sync policies
+// ============================================================================
+
+// Field type for NoSync: plain value with the same interface as AtomicCell
+template <typename U>
+class PlainCell {
+    U value{};
+public:
+    U load() const { return value; }          // Read of the other side's field
+    U loadOwn() const { return value; }       // Read of a field this side writes
+    void store(U v) { value = v; }            // Publish
+};
+
+// Field type for the concurrent policies: single-writer atomic with release/acquire
+template <typename U>
+class AtomicCell {
+    atomic<U> value{};
+public:
+    U load() const { return value.load(memory_order_acquire); }
+    U loadOwn() const { return value.load(memory_order_relaxed); }
+    void store(U v) { value.store(v, memory_order_release); }
+};
+
+struct NoLock {
+    void lock() {}
+    void unlock() {}
+};
+
+// Test-and-test-and-set lock; yields after a short spin
+class SpinLock {
+    atomic<bool> locked{false};
+public:
+    void lock() {
+        for (int spins = 0;; spins++) {
+            if (!locked.load(memory_order_relaxed) && !locked.exchange(true, memory_order_acquire)) return;
+            if (spins > 64) this_thread::yield();
+        }
+    }
+    void unlock() {
+        locked.store(false, memory_order_release);
+    }
+};
+
+struct NoSync {
+    template <typename U> using Cell = PlainCell<U>;
+    using ProducerLock = NoLock;
+    using ConsumerLock = NoLock;
+    static const size_t SIDE_ALIGN = alignof(void*);
+    static const bool THREADED = false;
+};
+
+struct SpscSync {
+    template <typename U> using Cell = AtomicCell<U>;
+    using ProducerLock = NoLock;
+    using ConsumerLock = NoLock;
+    static const size_t SIDE_ALIGN = 64;
+    static const bool THREADED = true;
+};
+
+struct MpscSync {
+    template <typename U> using Cell = AtomicCell<U>;
+    using ProducerLock = SpinLock;
+    using ConsumerLock = NoLock;
+    static const size_t SIDE_ALIGN = 64;
+    static const bool THREADED = true;
+};
+
+struct MpmcSync {
+    template <typename U> using Cell = AtomicCell<U>;
+    using ProducerLock = SpinLock;
+    using ConsumerLock = SpinLock;
+    static const size_t SIDE_ALIGN = 64;
+    static const bool THREADED = true;
+};
+
+// ============================================================================
+// Wait policies
+// ============================================================================
+
+struct SpinWait {
+    template <typename Ready>
+    void waitUntil(Ready ready) {
+        while (!ready()) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+    void notify() {}
+};
+
+struct YieldWait {
+    template <typename Ready>
+    void waitUntil(Ready ready) {
+        while (!ready()) this_thread::yield();
+    }
+    void notify() {}
+};
+
+/**
+ * Spins briefly, then sleeps in the kernel on a futex. notify() only makes a
+ * syscall when somebody is actually asleep.
+ */
+class FutexWait {
+    atomic<uint32_t> epoch{0};
+    atomic<uint32_t> sleepers{0};
+
+    static void futexWait(atomic<uint32_t>* addr, uint32_t expected) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+    static void futexWake(atomic<uint32_t>* addr, int count) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+
+public:
+    template <typename Ready>
+    void waitUntil(Ready ready) {
+        for (int spins = 0; spins < 100; spins++) {
+            if (ready()) return;
+        }
+        // ready() may consume (tryPop), so it must not be called again once it succeeded
+        for (;;) {
+            sleepers.fetch_add(1);
+            uint32_t seen = epoch.load();
+            // Re-check after announcing ourselves so a concurrent notify is not missed
+            bool done = ready();
+            if (!done) futexWait(&epoch, seen);
+            sleepers.fetch_sub(1);
+            if (done || ready()) return;
+        }
+    }
+
+    void notify() {
+        epoch.fetch_add(1);
+        if (sleepers.load() > 0) futexWake(&epoch, 1);
+    }
+};
+
+/**
+ * Spin-then-park with a learned spin budget. A wait goes through three phases:
+ * spin with exponential backoff (1, 2, 4 ... pause instructions between
+ * checks) until the budget is used up, yield a few times, then sleep on a
+ * futex. Each finished wait feeds its duration into a moving average. If
+ * waits usually end within the spin ceiling, the budget follows them at about
+ * twice the average, because spinning beats a park/wake round trip. If they
+ * usually take longer, spinning is pure waste, so the budget drops to the
+ * floor and an idle consumer parks almost at once. Telemetry counts how each
+ * wait ended.
+ */
+class AdaptiveWait {
+public:
+    static const uint32_t MIN_SPIN_NS = 200;
+    static const uint32_t MAX_SPIN_NS = 20000;   // Roughly a futex park + wake round trip
+    static const int MAX_PAUSES = 64;            // Backoff cap between two checks
+    static const int YIELDS = 4;
+
+    struct Telemetry {
+        uint64_t spinWakes;     // Waits that ended while spinning
+        uint64_t yieldWakes;    // Waits that ended in the yield phase
+        uint64_t parkedWaits;   // Waits that had to sleep
+        uint64_t futexSleeps;   // FUTEX_WAIT calls (a parked wait can sleep more than once)
+        uint64_t futexWakes;    // FUTEX_WAKE calls made by notify()
+        uint32_t spinBudgetNs;  // Current budget
+        uint32_t avgWaitNs;     // Moving average of wait durations
+    };
+
+private:
+    // The line producers read in notify()
+    alignas(64) atomic<uint32_t> epoch{0};
+    atomic<uint32_t> sleepers{0};
+
+    // Waiter-side state, written by learn() after every wait, so kept off the line above
+    alignas(64) atomic<uint32_t> spinBudgetNs{MAX_SPIN_NS / 4};
+    atomic<uint32_t> avgWaitNs{0};
+    atomic<uint64_t> spinWakes{0};
+    atomic<uint64_t> yieldWakes{0};
+    atomic<uint64_t> parkedWaits{0};
+    atomic<uint64_t> futexSleeps{0};
+    alignas(64) atomic<uint64_t> futexWakes{0};
+
+    static void futexWait(atomic<uint32_t>* addr, uint32_t expected) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+    static void futexWake(atomic<uint32_t>* addr, int count) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    static uint64_t nowNs() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+
+    // Updates the average (1/8 weight, racy but only a heuristic) and retargets the budget
+    void learn(uint64_t waitedNs, atomic<uint64_t>& outcome) {
+        outcome.fetch_add(1, memory_order_relaxed);
+        uint32_t sample = waitedNs > UINT32_MAX / 4 ? UINT32_MAX / 4 : (uint32_t)waitedNs;
+        uint32_t avg = avgWaitNs.load(memory_order_relaxed);
+        avg = avg == 0 ? sample : (uint32_t)(avg + ((int64_t)sample - avg) / 8);
+        avgWaitNs.store(avg, memory_order_relaxed);
+
+        uint32_t budget = MIN_SPIN_NS;
+        if (avg <= MAX_SPIN_NS / 2) budget = avg * 2 < MIN_SPIN_NS ? MIN_SPIN_NS : avg * 2;
+        spinBudgetNs.store(budget, memory_order_relaxed);
+    }
+
+public:
+    template <typename Ready>
+    void waitUntil(Ready ready) {
+        uint64_t start = nowNs();
+        uint64_t budget = spinBudgetNs.load(memory_order_relaxed);
+
+        // Phase 1: spin, doubling the pause count between checks; the clock is read
+        // once per round, so only a logarithmic number of times
+        for (int pauses = 1;; pauses = pauses < MAX_PAUSES ? pauses * 2 : MAX_PAUSES) {
+            for (int i = 0; i < pauses; i++) cpuRelax();
+            if (ready()) {
+                learn(nowNs() - start, spinWakes);
+                return;
+            }
+            if (nowNs() - start >= budget) break;
+        }
+
+        // Phase 2: give the CPU to whoever is about to make us ready
+        for (int i = 0; i < YIELDS; i++) {
+            this_thread::yield();
+            if (ready()) {
+                learn(nowNs() - start, yieldWakes);
+                return;
+            }
+        }
+
+        // Phase 3: park, exactly as FutexWait does
+        for (;;) {
+            sleepers.fetch_add(1);
+            uint32_t seen = epoch.load();
+            bool done = ready();
+            if (!done) {
+                futexSleeps.fetch_add(1, memory_order_relaxed);
+                futexWait(&epoch, seen);
+            }
+            sleepers.fetch_sub(1);
+            if (done || ready()) break;
+        }
+        learn(nowNs() - start, parkedWaits);
+    }
+
+    void notify() {
+        epoch.fetch_add(1);
+        if (sleepers.load() > 0) {
+            futexWakes.fetch_add(1, memory_order_relaxed);
+            futexWake(&epoch, 1);
+        }
+    }
+
+    Telemetry telemetry() const {
+        Telemetry t;
+        t.spinWakes = spinWakes.load(memory_order_relaxed);
+        t.yieldWakes = yieldWakes.load(memory_order_relaxed);
+        t.parkedWaits = parkedWaits.load(memory_order_relaxed);
+        t.futexSleeps = futexSleeps.load(memory_order_relaxed);
+        t.futexWakes = futexWakes.load(memory_order_relaxed);
+        t.spinBudgetNs = spinBudgetNs.load(memory_order_relaxed);
+        t.avgWaitNs = avgWaitNs.load(memory_order_relaxed);
+        return t;
+    }
+};
+
+// ============================================================================
+// Storage policies (single-producer / single-consumer safe over Sync::Cell)
+// ============================================================================
+
+struct LinkedStorage {
+    template <typename T, typename Sync>
+    class Impl {
+        struct Node {
+            T val{};
+            typename Sync::template Cell<Node*> next;
+        };
+
+        alignas(Sync::SIDE_ALIGN) Node* rearNode;    // Producer side
+        alignas(Sync::SIDE_ALIGN) Node* frontNode;   // Consumer side (dummy node)
+
+    public:
+        static const bool BOUNDED = false;
+
+        Impl() {
+            frontNode = rearNode = new Node();
+        }
+
+        bool tryPush(const T& data) {
+            Node* newNode = new Node();
+            newNode->val = data;
+            rearNode->next.store(newNode);
+            rearNode = newNode;
+            return true;
+        }
+
+        bool tryPop(T& out) {
+            Node* next = frontNode->next.load();
+            if (next == nullptr) return false;
+            out = next->val;
+            delete frontNode;
+            frontNode = next;
+            return true;
+        }
+
+        bool empty() const {
+            return frontNode->next.load() == nullptr;
+        }
+
+        ~Impl() {
+            while (frontNode != nullptr) {
+                Node* temp = frontNode;
+                frontNode = frontNode->next.loadOwn();
+                delete temp;
+            }
+        }
+    };
+};
+
+template <size_t BlockSize = 64>
+struct UnrolledStorage {
+    static_assert(BlockSize > 0, "block size must be positive");
+
+    template <typename T, typename Sync>
+    class Impl {
+        struct Block {
+            T items[BlockSize];
+            typename Sync::template Cell<size_t> committed;   // Slots published by the producer
+            typename Sync::template Cell<Block*> next;
+        };
+
+        struct alignas(Sync::SIDE_ALIGN) {
+            Block* block;
+            size_t index;
+        } producer;
+
+        struct alignas(Sync::SIDE_ALIGN) {
+            Block* block;
+            size_t index;
+        } consumer;
+
+    public:
+        static const bool BOUNDED = false;
+
+        Impl() {
+            producer.block = consumer.block = new Block();
+            producer.index = consumer.index = 0;
+        }
+
+        bool tryPush(const T& data) {
+            if (producer.index == BlockSize) {
+                Block* fresh = new Block();
+                producer.block->next.store(fresh);
+                producer.block = fresh;
+                producer.index = 0;
+            }
+            producer.block->items[producer.index++] = data;
+            producer.block->committed.store(producer.index);
+            return true;
+        }
+
+        bool tryPop(T& out) {
+            if (consumer.index == BlockSize) {
+                Block* next = consumer.block->next.load();
+                if (next == nullptr) return false;
+                delete consumer.block;
+                consumer.block = next;
+                consumer.index = 0;
+            }
+            if (consumer.index == consumer.block->committed.load()) return false;
+            out = consumer.block->items[consumer.index++];
+            return true;
+        }
+
+        bool empty() const {
+            if (consumer.index == BlockSize) {
+                Block* next = consumer.block->next.load();
+                return next == nullptr || next->committed.load() == 0;
+            }
+            return consumer.index == consumer.block->committed.load();
+        }
+
+        ~Impl() {
+            Block* block = consumer.block;
+            while (block != nullptr) {
+                Block* temp = block;
+                block = block->next.loadOwn();
+                delete temp;
+            }
+        }
+    };
+};
+
+template <size_t Capacity = 1024>
+struct RingStorage {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "ring capacity must be a power of two");
+
+    template <typename T, typename Sync>
+    class Impl {
+        T items[Capacity];
+        alignas(Sync::SIDE_ALIGN) typename Sync::template Cell<size_t> tail;   // Producer side
+        alignas(Sync::SIDE_ALIGN) typename Sync::template Cell<size_t> head;   // Consumer side
+
+    public:
+        static const bool BOUNDED = true;
+
+        bool tryPush(const T& data) {
+            size_t t = tail.loadOwn();
+            if (t - head.load() == Capacity) return false;
+            items[t & (Capacity - 1)] = data;
+            tail.store(t + 1);
+            return true;
+        }
+
+        bool tryPop(T& out) {
+            size_t h = head.loadOwn();
+            if (h == tail.load()) return false;
+            out = items[h & (Capacity - 1)];
+            head.store(h + 1);
+            return true;
+        }
+
+        bool empty() const {
+            return head.load() == tail.load();
+        }
+    };
+};
+
+// ============================================================================
+// The queue itself
+// ============================================================================
+
+template <typename T,
+          typename StoragePolicy = LinkedStorage,
+          typename SyncPolicy = NoSync,
+          typename WaitPolicy = YieldWait>
+class Queue {
+private:
+    using Storage = typename StoragePolicy::template Impl<T, SyncPolicy>;
+
+    Storage storage;
+    typename SyncPolicy::ProducerLock producerLock;
+    typename SyncPolicy::ConsumerLock consumerLock;
+    WaitPolicy notEmpty;   // Consumers wait here
+    WaitPolicy notFull;    // Producers wait here (bounded storage only)
+
+    // Scoped lock that compiles away for NoLock
+    template <typename Lock>
+    struct Guard {
+        Lock& lock;
+        explicit Guard(Lock& l) : lock(l) { lock.lock(); }
+        ~Guard() { lock.unlock(); }
+    };
+
+public:
+    Queue() = default;
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    /**
+     * Adds an element without blocking
+     * @return false if bounded storage is full
+     */
+    bool tryPush(const T& data) {
+        bool pushed;
+        {
+            Guard<typename SyncPolicy::ProducerLock> guard(producerLock);
+            pushed = storage.tryPush(data);
+        }
+        if (pushed) notEmpty.notify();
+        return pushed;
+    }
+
+    /**
+     * Removes the front element without blocking
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out) {
+        bool popped;
+        {
+            Guard<typename SyncPolicy::ConsumerLock> guard(consumerLock);
+            popped = storage.tryPop(out);
+        }
+        if (popped && Storage::BOUNDED) notFull.notify();
+        return popped;
+    }
+
+    /**
+     * Adds an element, waiting per WaitPolicy while bounded storage is full
+     */
+    void push(const T& data) {
+        static_assert(SyncPolicy::THREADED || !Storage::BOUNDED,
+                      "blocking push on a full single-threaded queue would never return");
+        if (tryPush(data)) return;
+        notFull.waitUntil([&]() { return tryPush(data); });
+    }
+
+    /**
+     * Removes the front element, waiting per WaitPolicy while the queue is empty
+     */
+    T pop() {
+        static_assert(SyncPolicy::THREADED, "blocking pop needs another thread to push; use tryPop");
+        T out{};
+        if (tryPop(out)) return out;
+        notEmpty.waitUntil([&]() { return tryPop(out); });
+        return out;
+    }
+
+    bool empty() const {
+        return storage.empty();
+    }
+
+    // Wait policy state, e.g. AdaptiveWait telemetry
+    const WaitPolicy& consumerWait() const { return notEmpty; }
+    const WaitPolicy& producerWait() const { return notFull; }
+};
+
+// ============================================================================
+// Configurations: pick one by changing the alias
+// ============================================================================
+
+using LocalQueue      = Queue<int, LinkedStorage, NoSync>;
+using LocalRing       = Queue<int, RingStorage<256>, NoSync>;
+using PipeQueue       = Queue<int, RingStorage<4096>, SpscSync, SpinWait>;
+using UnrolledPipe    = Queue<int, UnrolledStorage<128>, SpscSync, YieldWait>;
+using FanInQueue      = Queue<int, UnrolledStorage<128>, MpscSync, FutexWait>;
+using WorkQueue       = Queue<int, RingStorage<4096>, MpmcSync, FutexWait>;
+using LinkedWorkQueue = Queue<int, LinkedStorage, MpmcSync, YieldWait>;
+using AdaptiveWorkQueue = Queue<int, RingStorage<4096>, MpmcSync, AdaptiveWait>;
+using SpinningJobQueue  = Queue<int, LinkedStorage, SpscSync, SpinWait>;
+using AdaptiveJobQueue  = Queue<int, LinkedStorage, SpscSync, AdaptiveWait>;
+
+/**
+ * P producers and C consumers move `items` values; verifies the sum
+ * @return Million items per second
+ */
+template <typename Q>
+double runThreads(Q& q, int producers, int consumers, int items) {
+    atomic<long long> sum(0);
+    int perProducer = items / producers;
+    int total = perProducer * producers;
+    int perConsumer = total / consumers;
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < perProducer; i++) q.push(p * perProducer + i);
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        int quota = perConsumer + (c == consumers - 1 ? total - perConsumer * consumers : 0);
+        threads.emplace_back([&, quota]() {
+            long long local = 0;
+            for (int i = 0; i < quota; i++) local += q.pop();
+            sum += local;
+        });
+    }
+    for (auto& t : threads) t.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long expected = (long long)total * (total - 1) / 2;
+    if (sum.load() != expected) cout << "  Error: checksum mismatch" << endl;
+    return total / seconds / 1e6;
+}
+
+template <typename Q>
+double runThreads(int producers, int consumers, int items) {
+    Q q;
+    return runThreads(q, producers, consumers, items);
+}
+
+/**
+ * One producer sends `items` values `gapUs` apart; the consumer blocks in pop()
+ * @return CPU milliseconds the consumer thread burned while mostly idle
+ */
+template <typename Q>
+double consumerCpuMsWhenIdle(Q& q, int items, int gapUs) {
+    double cpuMs = 0;
+    thread consumer([&]() {
+        for (int i = 0; i < items; i++) q.pop();
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        cpuMs = ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+    });
+    for (int i = 0; i < items; i++) {
+        this_thread::sleep_for(chrono::microseconds(gapUs));
+        q.push(i);
+    }
+    consumer.join();
+    return cpuMs;
+}
+
+static void printTelemetry(const AdaptiveWait::Telemetry& t) {
+    cout << "    spin wakes " << t.spinWakes << ", yield wakes " << t.yieldWakes << ", parked " << t.parkedWaits
+         << " (futex sleeps " << t.futexSleeps << ", wakes " << t.futexWakes << "), avg wait " << t.avgWaitNs
+         << " ns, spin budget " << t.spinBudgetNs << " ns" << endl;
+}
+
+/**
+ * Main function - single-threaded behaviour and threaded configurations
+ */
+int main() {
+    cout << "=== Policy-Based Queue Demo ===" << endl;
+
+    cout << "\n--- Single-Threaded (NoSync) ---" << endl;
+    LocalQueue local;
+    local.tryPush(10);
+    local.tryPush(20);
+    local.tryPush(30);
+    int value = 0;
+    local.tryPop(value);
+    cout << "Pop: " << value << endl;   // Should print 10
+    local.tryPop(value);
+    cout << "Pop: " << value << endl;   // Should print 20
+
+    LocalRing ring;
+    int accepted = 0;
+    for (int i = 0; i < 300; i++) accepted += ring.tryPush(i);
+    cout << "Ring<256> accepted " << accepted << " of 300 pushes" << endl;  // Should print 256
+
+    cout << "\n--- Object Sizes ---" << endl;
+    cout << "LocalQueue: " << sizeof(LocalQueue) << " bytes (no locks, no padding)" << endl;
+    cout << "PipeQueue:  " << sizeof(PipeQueue) << " bytes (ring + padded indices)" << endl;
+
+    cout << "\n--- Threaded Configurations (Mitems/s) ---" << endl;
+    const int items = 1000000;
+    cout << "  SPSC ring    + spin : " << runThreads<PipeQueue>(1, 1, items) << endl;
+    cout << "  SPSC unrolled+ yield: " << runThreads<UnrolledPipe>(1, 1, items) << endl;
+    cout << "  MPSC unrolled+ futex: " << runThreads<FanInQueue>(4, 1, items) << endl;
+    cout << "  MPMC ring    + futex: " << runThreads<WorkQueue>(4, 4, items) << endl;
+    cout << "  MPMC linked  + yield: " << runThreads<LinkedWorkQueue>(4, 4, items) << endl;
+    AdaptiveWorkQueue adaptiveQueue;
+    cout << "  MPMC ring    + adapt: " << runThreads(adaptiveQueue, 4, 4, items) << endl;
+    printTelemetry(adaptiveQueue.consumerWait().telemetry());
+
+    cout << "\n--- Mostly Idle Consumer: 200 items, 1 ms apart ---" << endl;
+    SpinningJobQueue spinning;
+    cout << "  spin wait    : consumer CPU " << consumerCpuMsWhenIdle(spinning, 200, 1000) << " ms" << endl;
+    AdaptiveJobQueue adaptiveJobs;
+    cout << "  adaptive wait: consumer CPU " << consumerCpuMsWhenIdle(adaptiveJobs, 200, 1000) << " ms" << endl;
+    printTelemetry(adaptiveJobs.consumerWait().telemetry());   // Mostly parked, budget at the floor
+
+    return 0;
+}
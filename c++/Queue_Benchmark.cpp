@@ -0,0 +1,472 @@
+/*
+ * Queue Benchmark Suite
+ *
+ * Measures the linked-list Queue (see Queue_using_LinkedLIst.cpp) against the
+ * standard library alternatives so we have data to pick a backend per use case.
+ *
+ * Workloads:
+ * - push:    N pushes into an empty queue
+ * - pop:     N pops from a queue pre-filled with N items
+ * - mixed:   random 50/50 push/pop around a warm queue of N/2 items
+ * - burst:   repeated bursts of B pushes followed by B pops
+ * - latency: per-operation p50 / p99 / p99.9 / max over the mixed workload
+ *            (mixed ns/op therefore includes the clock read overhead)
+ * - rss:     resident memory growth after filling N items (measured in a child process)
+ * - threads: P producers + P consumers sharing one mutex-guarded queue
+ *
+ * Results are printed to stdout as a single JSON document.
+ *
+ * Usage:
+ *   ./queue_benchmark [--sizes 1000,1000000] [--threads 1,2,4] [--large]
+ *   --large appends the 100M element size (needs several GB of RAM)
+ *
+ * Adding a backend: write an adapter with push(int), pop() and size() and
+ * register it in runAllBackends(). Backends living in other files carry their
+ * own comparison against Queue in their main() demo.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <limits>
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// ----------- Node Class (Single Linked List Node) ------------
+class LinkedList {
+public:
+    int val;             // Stores the data of the node
+    LinkedList* next;    // Pointer to the next node
+
+    LinkedList(int data) {
+        val = data;
+        next = nullptr;
+    }
+};
+
+// ----------- Queue Class Using Linked List ------------
+// Same implementation as Queue_using_LinkedLIst.cpp so the numbers are comparable.
+class Queue {
+private:
+    LinkedList* frontNode;
+    LinkedList* rearNode;
+    int count;
+
+public:
+    Queue() {
+        frontNode = rearNode = nullptr;
+        count = 0;
+    }
+
+    int front() {
+        if (frontNode == nullptr) {
+            cout << "Queue is empty\n";
+            return -1;
+        }
+        return frontNode->val;
+    }
+
+    int size() {
+        return count;
+    }
+
+    int pop() {
+        if (frontNode == nullptr) {
+            cout << "Queue is empty\n";
+            return -1;
+        }
+        LinkedList* temp = frontNode;
+        int data = frontNode->val;
+        frontNode = frontNode->next;
+        if (frontNode == nullptr) {
+            rearNode = nullptr;
+        }
+        delete temp;
+        count--;
+        return data;
+    }
+
+    void push(int data) {
+        LinkedList* newNode = new LinkedList(data);
+        if (rearNode == nullptr) {
+            frontNode = rearNode = newNode;
+        } else {
+            rearNode->next = newNode;
+            rearNode = newNode;
+        }
+        count++;
+    }
+
+    ~Queue() {
+        while (frontNode != nullptr) {
+            LinkedList* temp = frontNode;
+            frontNode = frontNode->next;
+            delete temp;
+        }
+    }
+};
+
+// ----------- Backend Adapters ------------
+// Every backend exposes push(int), pop() and size() so the workloads are written once.
+
+class LinkedQueueBackend {
+    Queue q;
+public:
+    static const char* name() { return "linked_queue"; }
+    void push(int x) { q.push(x); }
+    int pop() { return q.pop(); }
+    size_t size() { return q.size(); }
+};
+
+class StdQueueBackend {
+    queue<int> q;
+public:
+    static const char* name() { return "std_queue"; }
+    void push(int x) { q.push(x); }
+    int pop() { int v = q.front(); q.pop(); return v; }
+    size_t size() { return q.size(); }
+};
+
+class StdDequeBackend {
+    deque<int> q;
+public:
+    static const char* name() { return "std_deque"; }
+    void push(int x) { q.push_back(x); }
+    int pop() { int v = q.front(); q.pop_front(); return v; }
+    size_t size() { return q.size(); }
+};
+
+// ----------- Helpers ------------
+
+// Prevents the optimizer from discarding popped values
+static volatile long long benchmarkSink = 0;
+
+double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+}
+
+/**
+ * Reads the current resident set size of this process
+ * @return RSS in kilobytes, or -1 if /proc is unavailable
+ */
+long readRssKb() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return stol(line.substr(6));
+        }
+    }
+    return -1;
+}
+
+double percentile(vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = (size_t)(p * (sorted.size() - 1));
+    return sorted[idx];
+}
+
+/**
+ * Result of one backend on one size
+ */
+struct SizeResult {
+    size_t n = 0;
+    double pushNsPerOp = 0, popNsPerOp = 0, mixedNsPerOp = 0, burstNsPerOp = 0;
+    double p50 = 0, p99 = 0, p999 = 0, pmax = 0;
+    long rssKb = -1;
+};
+
+struct ThreadResult {
+    int producers = 0;
+    double opsPerSec = 0;
+};
+
+// ----------- Workloads ------------
+
+template <typename Backend>
+double benchPush(size_t n) {
+    Backend b;
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++) b.push((int)i);
+    auto end = Clock::now();
+    return elapsedNs(start, end) / n;
+}
+
+template <typename Backend>
+double benchPop(size_t n) {
+    Backend b;
+    for (size_t i = 0; i < n; i++) b.push((int)i);
+    long long sum = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++) sum += b.pop();
+    auto end = Clock::now();
+    benchmarkSink += sum;
+    return elapsedNs(start, end) / n;
+}
+
+/**
+ * Random push/pop mix around a warm queue; also collects per-op latencies
+ * @param latencies Receives one sample per operation (ns)
+ */
+template <typename Backend>
+double benchMixed(size_t n, vector<double>& latencies) {
+    Backend b;
+    size_t warm = max<size_t>(n / 2, 1);
+    for (size_t i = 0; i < warm; i++) b.push((int)i);
+
+    mt19937 gen(42);
+    bernoulli_distribution coin(0.5);
+    vector<char> ops(n);
+    for (auto& op : ops) op = coin(gen);
+
+    latencies.clear();
+    latencies.reserve(n);
+    long long sum = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        auto t0 = Clock::now();
+        if (ops[i] || b.size() == 0) b.push((int)i);
+        else sum += b.pop();
+        auto t1 = Clock::now();
+        latencies.push_back(elapsedNs(t0, t1));
+    }
+    auto end = Clock::now();
+    benchmarkSink += sum;
+    return elapsedNs(start, end) / n;
+}
+
+template <typename Backend>
+double benchBurst(size_t n, size_t burst = 256) {
+    Backend b;
+    size_t rounds = max<size_t>(n / burst, 1);
+    long long sum = 0;
+    auto start = Clock::now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < burst; i++) b.push((int)i);
+        for (size_t i = 0; i < burst; i++) sum += b.pop();
+    }
+    auto end = Clock::now();
+    benchmarkSink += sum;
+    return elapsedNs(start, end) / (rounds * burst * 2);
+}
+
+/**
+ * Measures RSS growth of filling n items in a forked child so that
+ * freed-but-cached heap from earlier runs does not hide the cost.
+ */
+template <typename Backend>
+long benchRss(size_t n) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        readRssKb();  // warm up so the ifstream's own buffers are not counted
+        long before = readRssKb();
+        Backend* b = new Backend();
+        for (size_t i = 0; i < n; i++) b->push((int)i);
+        long after = readRssKb();
+        long delta = (before < 0 || after < 0) ? -1 : after - before;
+        ssize_t written = write(fds[1], &delta, sizeof(delta));
+        (void)written;
+        close(fds[1]);
+        _exit(0);
+    }
+    close(fds[1]);
+    long delta = -1;
+    if (read(fds[0], &delta, sizeof(delta)) != (ssize_t)sizeof(delta)) delta = -1;
+    close(fds[0]);
+    waitpid(pid, nullptr, 0);
+    return delta;
+}
+
+/**
+ * P producers and P consumers hammer one backend guarded by a mutex.
+ * The linked Queue is not thread-safe, so the lock is part of what is measured.
+ */
+template <typename Backend>
+double benchThreads(size_t totalItems, int producers) {
+    Backend b;
+    mutex m;
+    size_t perProducer = max<size_t>(totalItems / producers, 1);
+    size_t expected = perProducer * producers;
+    atomic<size_t> consumed(0);
+
+    auto start = Clock::now();
+    vector<thread> workers;
+    for (int p = 0; p < producers; p++) {
+        workers.emplace_back([&, p]() {
+            for (size_t i = 0; i < perProducer; i++) {
+                lock_guard<mutex> lock(m);
+                b.push((int)(p * perProducer + i));
+            }
+        });
+    }
+    for (int c = 0; c < producers; c++) {
+        workers.emplace_back([&]() {
+            long long sum = 0;
+            while (consumed.load(memory_order_relaxed) < expected) {
+                bool got = false;
+                {
+                    lock_guard<mutex> lock(m);
+                    if (b.size() > 0) {
+                        sum += b.pop();
+                        got = true;
+                    }
+                }
+                if (got) consumed.fetch_add(1, memory_order_relaxed);
+                else this_thread::yield();
+            }
+            benchmarkSink += sum;
+        });
+    }
+    for (auto& t : workers) t.join();
+    auto end = Clock::now();
+    return expected * 2 / (elapsedNs(start, end) / 1e9);
+}
+
+// ----------- Runner & JSON Output ------------
+
+struct BenchConfig {
+    vector<size_t> sizes = {1000, 1000000};
+    vector<int> threads = {1, 2, 4};
+};
+
+template <typename Backend>
+void runBackend(const BenchConfig& cfg, ostringstream& json, bool last) {
+    json << "    {\n      \"backend\": \"" << Backend::name() << "\",\n      \"sizes\": [\n";
+    for (size_t s = 0; s < cfg.sizes.size(); s++) {
+        size_t n = cfg.sizes[s];
+        cerr << "[bench] " << Backend::name() << " n=" << n << endl;
+
+        SizeResult r;
+        r.n = n;
+        r.pushNsPerOp = benchPush<Backend>(n);
+        r.popNsPerOp = benchPop<Backend>(n);
+        vector<double> lat;
+        r.mixedNsPerOp = benchMixed<Backend>(n, lat);
+        sort(lat.begin(), lat.end());
+        r.p50 = percentile(lat, 0.50);
+        r.p99 = percentile(lat, 0.99);
+        r.p999 = percentile(lat, 0.999);
+        r.pmax = lat.empty() ? 0 : lat.back();
+        r.burstNsPerOp = benchBurst<Backend>(n);
+        r.rssKb = benchRss<Backend>(n);
+
+        json << "        {\"n\": " << r.n
+             << ", \"push_ns_per_op\": " << r.pushNsPerOp
+             << ", \"pop_ns_per_op\": " << r.popNsPerOp
+             << ", \"mixed_ns_per_op\": " << r.mixedNsPerOp
+             << ", \"burst_ns_per_op\": " << r.burstNsPerOp
+             << ", \"latency_ns\": {\"p50\": " << r.p50 << ", \"p99\": " << r.p99
+             << ", \"p999\": " << r.p999 << ", \"max\": " << r.pmax << "}"
+             << ", \"rss_kb\": " << r.rssKb << "}"
+             << (s + 1 < cfg.sizes.size() ? ",\n" : "\n");
+    }
+    json << "      ],\n      \"threads\": [\n";
+
+    // Thread scaling uses the smallest configured size, clamped to 100K..1M items
+    // so runs stay short but each thread still has measurable work
+    size_t threadItems = 1000000;
+    for (size_t n : cfg.sizes) threadItems = min(threadItems, max<size_t>(n, 100000));
+    for (size_t t = 0; t < cfg.threads.size(); t++) {
+        ThreadResult tr;
+        tr.producers = cfg.threads[t];
+        tr.opsPerSec = benchThreads<Backend>(threadItems, tr.producers);
+        json << "        {\"producers\": " << tr.producers << ", \"consumers\": " << tr.producers
+             << ", \"items\": " << threadItems << ", \"ops_per_sec\": " << tr.opsPerSec << "}"
+             << (t + 1 < cfg.threads.size() ? ",\n" : "\n");
+    }
+    json << "      ]\n    }" << (last ? "\n" : ",\n");
+}
+
+/**
+ * Runs every registered backend; new backends go in this list
+ */
+string runAllBackends(const BenchConfig& cfg) {
+    ostringstream json;
+    json.precision(2);
+    json << fixed;
+    json << "{\n  \"benchmark\": \"queue_backends\",\n  \"results\": [\n";
+    runBackend<LinkedQueueBackend>(cfg, json, false);
+    runBackend<StdQueueBackend>(cfg, json, false);
+    runBackend<StdDequeBackend>(cfg, json, true);
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+/**
+ * Parses a comma separated list of positive integers
+ * @param out Receives the values
+ * @return false if an entry is not a number, is zero or does not fit in T
+ */
+template <typename T>
+bool parseList(const string& text, vector<T>& out) {
+    out.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        if (item.find_first_not_of("0123456789") != string::npos) return false;
+        errno = 0;
+        unsigned long long value = strtoull(item.c_str(), nullptr, 10);
+        if (errno == ERANGE || value == 0 || value > (unsigned long long)numeric_limits<T>::max()) return false;
+        out.push_back((T)value);
+    }
+    return true;
+}
+
+/**
+ * Main function - parses options and prints JSON results
+ */
+int main(int argc, char* argv[]) {
+    BenchConfig cfg;
+
+    const string usage = string("Usage: ") + argv[0] + " [--sizes 1000,1000000] [--threads 1,2,4] [--large]\n"
+                         "       sizes and thread counts are positive integers";
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool ok = true;
+        if (arg == "--sizes" && i + 1 < argc) {
+            ok = parseList<size_t>(argv[++i], cfg.sizes);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            ok = parseList<int>(argv[++i], cfg.threads);
+        } else if (arg == "--large") {
+            cfg.sizes.push_back(100000000);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            cerr << usage << endl;
+            return 1;
+        }
+    }
+
+    if (cfg.sizes.empty() || cfg.threads.empty()) {
+        cerr << "Error: sizes and threads must not be empty." << endl;
+        return 1;
+    }
+
+    cout << runAllBackends(cfg);
+    return 0;
+}
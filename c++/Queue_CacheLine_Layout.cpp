@@ -0,0 +1,206 @@
+/*
+ * Cache-Line-Aware Concurrent Queue Layout
+ *
+ * In the plain Queue, frontNode, rearNode and count sit next to each other in one
+ * object. Once a producer thread writes rearNode and a consumer thread writes
+ * frontNode, both fields live on the same 64-byte cache line and every push
+ * invalidates the consumer's copy (and vice versa): false sharing. The shared
+ * count is worse, because both sides write it.
+ *
+ * This file shows a single-producer / single-consumer linked queue in two layouts:
+ *
+ * - Packed:  producer and consumer state adjacent, as in Queue
+ * - Padded:  producer state and consumer state each on their own cache line
+ *
+ * The shared count is split into per-side counters (pushed / popped), each
+ * written by exactly one thread. size() is pushed - popped and is approximate
+ * while both threads are running.
+ *
+ * The benchmark in main() runs both layouts with the producer and consumer on
+ * separate threads. For hardware-level numbers run it under
+ *   perf stat -e cache-misses,cache-references ./queue_cacheline
+ * and compare the two phases.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Destructive interference size; fixed at 64 since GCC warns on the std constant's ABI
+static const size_t CACHE_LINE_SIZE = 64;
+
+// ----------- Node Class (Single Linked List Node) ------------
+class LinkedList {
+public:
+    int val;                         // Stores the data of the node
+    atomic<LinkedList*> next;        // Published by the producer, read by the consumer
+
+    explicit LinkedList(int data) : val(data), next(nullptr) {}
+};
+
+// ----------- SPSC Queue with selectable layout ------------
+/**
+ * Single-producer / single-consumer queue using a dummy head node.
+ * push() may only be called from one thread and pop() from one (other) thread.
+ * @tparam Padded true places producer and consumer state on separate cache lines
+ */
+template <bool Padded>
+class SpscQueue {
+private:
+    static const size_t SIDE_ALIGN = Padded ? CACHE_LINE_SIZE : alignof(void*);
+
+    // Written only by the producer
+    struct alignas(SIDE_ALIGN) ProducerSide {
+        LinkedList* rearNode;
+        atomic<uint64_t> pushed;
+    };
+
+    // Written only by the consumer
+    struct alignas(SIDE_ALIGN) ConsumerSide {
+        LinkedList* frontNode;       // Dummy node; the real front is frontNode->next
+        atomic<uint64_t> popped;
+    };
+
+    ProducerSide producer;
+    ConsumerSide consumer;
+
+public:
+    SpscQueue() {
+        LinkedList* dummy = new LinkedList(0);
+        producer.rearNode = dummy;
+        producer.pushed.store(0, memory_order_relaxed);
+        consumer.frontNode = dummy;
+        consumer.popped.store(0, memory_order_relaxed);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Adds an element to the rear of the queue (producer thread only)
+     * @param data The value to enqueue
+     */
+    void push(int data) {
+        LinkedList* newNode = new LinkedList(data);
+        producer.rearNode->next.store(newNode, memory_order_release);
+        producer.rearNode = newNode;
+        // Single writer, so a plain load + store is enough; no RMW bouncing
+        producer.pushed.store(producer.pushed.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+
+    /**
+     * Removes the front element (consumer thread only)
+     * @param out Receives the dequeued value
+     * @return false if the queue was empty
+     */
+    bool pop(int& out) {
+        LinkedList* next = consumer.frontNode->next.load(memory_order_acquire);
+        if (next == nullptr) return false;
+        out = next->val;
+        delete consumer.frontNode;
+        consumer.frontNode = next;   // The popped node becomes the new dummy
+        consumer.popped.store(consumer.popped.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Returns the approximate number of elements; exact when both sides are idle
+     */
+    size_t size() const {
+        uint64_t popped = consumer.popped.load(memory_order_relaxed);
+        uint64_t pushed = producer.pushed.load(memory_order_relaxed);
+        return pushed > popped ? (size_t)(pushed - popped) : 0;
+    }
+
+    /**
+     * Byte distance between the producer and consumer state, for the layout report
+     */
+    static size_t sideDistance() {
+        return offsetof(SpscQueue, consumer) - offsetof(SpscQueue, producer);
+    }
+
+    ~SpscQueue() {
+        LinkedList* node = consumer.frontNode;
+        while (node != nullptr) {
+            LinkedList* temp = node;
+            node = node->next.load(memory_order_relaxed);
+            delete temp;
+        }
+    }
+};
+
+using PackedQueue = SpscQueue<false>;
+using PaddedQueue = SpscQueue<true>;
+
+/**
+ * Streams items from one producer thread to one consumer thread
+ * @return Million items per second
+ */
+template <typename Q>
+double runSpsc(int items) {
+    Q q;
+    long long sum = 0;
+    auto start = chrono::steady_clock::now();
+
+    thread producerThread([&]() {
+        for (int i = 0; i < items; i++) q.push(i);
+    });
+    thread consumerThread([&]() {
+        int received = 0, value;
+        while (received < items) {
+            if (q.pop(value)) {
+                sum += value;
+                received++;
+            } else {
+                this_thread::yield();
+            }
+        }
+    });
+
+    producerThread.join();
+    consumerThread.join();
+    auto end = chrono::steady_clock::now();
+
+    long long expected = (long long)items * (items - 1) / 2;
+    if (sum != expected) cout << "  Error: checksum mismatch" << endl;
+    return items / chrono::duration<double>(end - start).count() / 1e6;
+}
+
+/**
+ * Main function - layout report, functional check and benchmark
+ */
+int main() {
+    cout << "=== Cache-Line-Aware Queue Layout ===" << endl;
+
+    cout << "\n--- Layout ---" << endl;
+    cout << "Packed: sizeof=" << sizeof(PackedQueue)
+         << " producer/consumer distance=" << PackedQueue::sideDistance() << " bytes" << endl;
+    cout << "Padded: sizeof=" << sizeof(PaddedQueue)
+         << " producer/consumer distance=" << PaddedQueue::sideDistance() << " bytes" << endl;
+
+    cout << "\n--- Single Thread ---" << endl;
+    PaddedQueue q;
+    q.push(10);
+    q.push(20);
+    q.push(30);
+    cout << "Size: " << q.size() << endl;  // Should print 3
+    int value = -1;
+    q.pop(value);
+    cout << "Pop: " << value << endl;      // Should print 10
+    cout << "Size: " << q.size() << endl;  // Should print 2
+
+    cout << "\n--- SPSC Throughput (Mitems/s, producer and consumer on separate threads) ---" << endl;
+    const int items = 5000000;
+    for (int round = 0; round < 3; round++) {
+        double packed = runSpsc<PackedQueue>(items);
+        double padded = runSpsc<PaddedQueue>(items);
+        cout << "  round " << round + 1 << " | packed: " << packed << " | padded: " << padded << endl;
+    }
+
+    return 0;
+}
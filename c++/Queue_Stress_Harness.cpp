@@ -0,0 +1,449 @@
+/*
+ * Concurrent Queue Stress & Linearizability Harness
+ *
+ * Before a concurrent Queue variant is trusted (or after anyone "optimizes" one)
+ * it has to pass two kinds of checks, both run by this harness:
+ *
+ * 1. Stress run: randomized multi-producer / multi-consumer workload. Every item
+ *    is tagged (producer id, sequence number), so afterwards we can prove:
+ *    - no loss: every tag was popped
+ *    - no duplication: no tag was popped twice
+ *    - per-producer FIFO: each consumer saw every producer's items in order
+ *    Throughput is reported next to the verdict, so a speed-up that breaks
+ *    semantics cannot go unnoticed.
+ * 2. Linearizability: many tiny randomized histories (invocation and response
+ *    stamps on a global logical clock) are checked against a sequential FIFO
+ *    model with a Wing & Gong style backtracking search.
+ *
+ * Build it with -fsanitize=thread as well; the harness itself is race free, so
+ * every TSan report points at the queue under test.
+ *
+ * Operations to support:
+ * - stressTest<Q>(name, config): Runs the workload and prints the verdict
+ * - linearizabilityTest<Q>(name, trials): Checks small random histories
+ * - Any queue with bool tryPush(uint64_t) and bool tryPop(uint64_t&) can be plugged in
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <set>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+// ----------- Queues under test ------------
+
+/**
+ * The LinkedList-based Queue behind one mutex
+ */
+class LockedQueue {
+private:
+    struct Node {
+        uint64_t val;
+        Node* next;
+        explicit Node(uint64_t data) : val(data), next(nullptr) {}
+    };
+    Node* frontNode = nullptr;
+    Node* rearNode = nullptr;
+    mutex lock;
+
+public:
+    bool tryPush(uint64_t data) {
+        Node* newNode = new Node(data);
+        lock_guard<mutex> guard(lock);
+        if (rearNode == nullptr) {
+            frontNode = rearNode = newNode;
+        } else {
+            rearNode->next = newNode;
+            rearNode = newNode;
+        }
+        return true;
+    }
+
+    bool tryPop(uint64_t& out) {
+        Node* temp;
+        {
+            lock_guard<mutex> guard(lock);
+            if (frontNode == nullptr) return false;
+            temp = frontNode;
+            frontNode = frontNode->next;
+            if (frontNode == nullptr) rearNode = nullptr;
+        }
+        out = temp->val;
+        delete temp;
+        return true;
+    }
+
+    ~LockedQueue() {
+        uint64_t ignored;
+        while (tryPop(ignored)) {
+        }
+    }
+};
+
+/**
+ * Michael-Scott lock-free queue. Unlinked nodes are parked and freed in the
+ * destructor, which keeps the harness free of a reclamation scheme.
+ */
+class LockFreeQueue {
+private:
+    struct Node {
+        uint64_t val;
+        atomic<Node*> next{nullptr};
+        Node* retiredNext = nullptr;
+        explicit Node(uint64_t data) : val(data) {}
+    };
+    alignas(64) atomic<Node*> frontNode;
+    alignas(64) atomic<Node*> rearNode;
+    alignas(64) atomic<Node*> retired{nullptr};
+
+public:
+    LockFreeQueue() {
+        Node* dummy = new Node(0);
+        frontNode.store(dummy);
+        rearNode.store(dummy);
+    }
+
+    bool tryPush(uint64_t data) {
+        Node* newNode = new Node(data);
+        while (true) {
+            Node* rear = rearNode.load(memory_order_acquire);
+            Node* next = rear->next.load(memory_order_acquire);
+            if (next != nullptr) {
+                rearNode.compare_exchange_weak(rear, next);
+                continue;
+            }
+            if (rear->next.compare_exchange_weak(next, newNode, memory_order_release, memory_order_relaxed)) {
+                rearNode.compare_exchange_strong(rear, newNode);
+                return true;
+            }
+        }
+    }
+
+    bool tryPop(uint64_t& out) {
+        while (true) {
+            Node* front = frontNode.load(memory_order_acquire);
+            Node* next = front->next.load(memory_order_acquire);
+            if (next == nullptr) return false;
+            Node* rear = rearNode.load(memory_order_acquire);
+            if (front == rear) {
+                rearNode.compare_exchange_weak(rear, next);
+                continue;
+            }
+            uint64_t value = next->val;
+            if (frontNode.compare_exchange_weak(front, next, memory_order_acq_rel, memory_order_relaxed)) {
+                out = value;
+                Node* head = retired.load(memory_order_relaxed);
+                do {
+                    front->retiredNext = head;
+                } while (!retired.compare_exchange_weak(head, front, memory_order_release, memory_order_relaxed));
+                return true;
+            }
+        }
+    }
+
+    ~LockFreeQueue() {
+        for (Node* node = frontNode.load(); node != nullptr;) {
+            Node* temp = node;
+            node = node->next.load();
+            delete temp;
+        }
+        for (Node* node = retired.load(); node != nullptr;) {
+            Node* temp = node;
+            node = node->retiredNext;
+            delete temp;
+        }
+    }
+};
+
+/**
+ * Deliberately broken: pushes go to a random lane, so one producer's items can
+ * overtake each other. Every lane is a correct locked queue, so nothing is lost
+ * and only the ordering checks can catch it.
+ */
+class RandomLaneQueue {
+private:
+    LockedQueue lanes[4];
+    atomic<unsigned> popCursor{0};
+
+public:
+    bool tryPush(uint64_t data) {
+        thread_local minstd_rand rng(random_device{}());
+        return lanes[rng() % 4].tryPush(data);
+    }
+
+    bool tryPop(uint64_t& out) {
+        unsigned start = popCursor.fetch_add(1, memory_order_relaxed);
+        for (unsigned i = 0; i < 4; i++) {
+            if (lanes[(start + i) % 4].tryPop(out)) return true;
+        }
+        return false;
+    }
+};
+
+// ----------- Item tags ------------
+
+static uint64_t makeTag(uint64_t producer, uint64_t sequence) { return (producer << 40) | sequence; }
+static uint64_t tagProducer(uint64_t tag) { return tag >> 40; }
+static uint64_t tagSequence(uint64_t tag) { return tag & ((1ULL << 40) - 1); }
+
+// ----------- Stress test ------------
+
+struct StressConfig {
+    int producers = 4;
+    int consumers = 4;
+    uint64_t itemsPerProducer = 100000;
+    unsigned seed = 1;
+    int pauseOneIn = 64;   // A random yield every ~N operations shakes up interleavings
+};
+
+struct StressReport {
+    uint64_t lost = 0;
+    uint64_t duplicated = 0;
+    uint64_t reordered = 0;   // Consumer saw a producer's sequence go backwards
+    double seconds = 0;
+
+    bool passed() const { return lost == 0 && duplicated == 0 && reordered == 0; }
+};
+
+/**
+ * Runs the randomized MPMC workload against a fresh Q and verifies the result
+ */
+template <typename Q>
+StressReport stressTest(const string& name, const StressConfig& config) {
+    Q queue;
+    uint64_t total = config.itemsPerProducer * config.producers;
+    atomic<int> producersLeft{config.producers};
+    vector<vector<uint64_t>> seen(config.consumers);   // What each consumer popped, in order
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int p = 0; p < config.producers; p++) {
+        threads.emplace_back([&, p] {
+            minstd_rand rng(config.seed * 7919 + p);
+            for (uint64_t s = 0; s < config.itemsPerProducer; s++) {
+                while (!queue.tryPush(makeTag(p, s))) this_thread::yield();
+                if (rng() % config.pauseOneIn == 0) this_thread::yield();
+            }
+            producersLeft.fetch_sub(1, memory_order_release);
+        });
+    }
+    for (int c = 0; c < config.consumers; c++) {
+        threads.emplace_back([&, c] {
+            minstd_rand rng(config.seed * 104729 + c);
+            vector<uint64_t>& mine = seen[c];
+            mine.reserve(total / config.consumers + 1024);
+            uint64_t tag = 0;
+            // Stop on the first empty pop after every producer finished, instead of
+            // waiting for a count that a queue losing items would never reach
+            while (true) {
+                bool producersDone = producersLeft.load(memory_order_acquire) == 0;
+                if (queue.tryPop(tag)) {
+                    mine.push_back(tag);
+                } else if (producersDone) {
+                    break;
+                } else {
+                    this_thread::yield();
+                }
+                if (rng() % config.pauseOneIn == 0) this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    StressReport report;
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<vector<uint8_t>> hits(config.producers, vector<uint8_t>(config.itemsPerProducer, 0));
+    for (const auto& mine : seen) {
+        vector<int64_t> last(config.producers, -1);
+        for (uint64_t tag : mine) {
+            uint64_t p = tagProducer(tag), s = tagSequence(tag);
+            if (p >= (uint64_t)config.producers || s >= config.itemsPerProducer) {
+                report.duplicated++;   // A value nobody pushed counts as corruption
+                continue;
+            }
+            if (hits[p][s]++) report.duplicated++;
+            if ((int64_t)s < last[p]) report.reordered++;
+            last[p] = (int64_t)s;
+        }
+    }
+    for (const auto& row : hits) {
+        for (uint8_t hit : row) report.lost += hit == 0;
+    }
+
+    cout << left << setw(16) << name << right << (report.passed() ? "PASS" : "FAIL") << "  lost " << report.lost
+         << ", dup " << report.duplicated << ", reordered " << report.reordered << " | " << fixed
+         << setprecision(2) << total / report.seconds / 1e6 << " M items/s" << endl;
+    cout.unsetf(ios::fixed);
+    return report;
+}
+
+// ----------- Linearizability checker ------------
+
+struct Operation {
+    bool isPush;
+    uint64_t value;      // Pushed value, or popped value when ok
+    bool ok;             // false: pop found the queue empty, or push was rejected (full)
+    uint64_t invoked;    // Logical timestamps
+    uint64_t responded;
+};
+
+/**
+ * Wing & Gong search: repeatedly pick an operation that can go next (none of
+ * the remaining operations finished before it started), apply it to a
+ * sequential FIFO model, and backtrack on mismatch. Visited (done-set, model
+ * state) pairs are memoized so small histories stay fast.
+ */
+class LinearizabilityChecker {
+private:
+    const vector<Operation>& history;
+    set<pair<uint64_t, vector<uint64_t>>> visited;
+
+    bool search(uint64_t done, vector<uint64_t>& model) {
+        if (done == (1ULL << history.size()) - 1) return true;
+        if (!visited.insert({done, model}).second) return false;
+
+        // An op can be linearized next only if it was invoked before every remaining op responded
+        uint64_t earliestResponse = UINT64_MAX;
+        for (size_t i = 0; i < history.size(); i++) {
+            if (!(done >> i & 1) && history[i].responded < earliestResponse) earliestResponse = history[i].responded;
+        }
+        for (size_t i = 0; i < history.size(); i++) {
+            if ((done >> i & 1) || history[i].invoked > earliestResponse) continue;
+            const Operation& op = history[i];
+            if (op.isPush && !op.ok) {
+                // A rejected push left the queue unchanged
+                if (search(done | 1ULL << i, model)) return true;
+            } else if (op.isPush) {
+                model.push_back(op.value);
+                if (search(done | 1ULL << i, model)) return true;
+                model.pop_back();
+            } else if (!op.ok) {
+                if (model.empty() && search(done | 1ULL << i, model)) return true;
+            } else if (!model.empty() && model.front() == op.value) {
+                model.erase(model.begin());
+                bool found = search(done | 1ULL << i, model);
+                model.insert(model.begin(), op.value);
+                if (found) return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit LinearizabilityChecker(const vector<Operation>& h) : history(h) {}
+
+    bool check() {
+        vector<uint64_t> model;
+        return search(0, model);
+    }
+};
+
+/**
+ * Records `trials` small random histories (3 threads x 4 ops) and checks each one
+ * @return Number of histories that are not linearizable
+ */
+template <typename Q>
+int linearizabilityTest(const string& name, int trials, unsigned seed) {
+    const int threadsPerTrial = 3, opsPerThread = 4;
+    int failures = 0;
+    for (int trial = 0; trial < trials; trial++) {
+        Q queue;
+        atomic<uint64_t> clock{0};
+        atomic<int> ready{0};
+        vector<vector<Operation>> perThread(threadsPerTrial);
+        vector<thread> threads;
+        for (int t = 0; t < threadsPerTrial; t++) {
+            threads.emplace_back([&, t] {
+                minstd_rand rng(seed + trial * 31 + t);
+                ready.fetch_add(1);
+                while (ready.load() < threadsPerTrial) {
+                }
+                for (int k = 0; k < opsPerThread; k++) {
+                    Operation op{};
+                    op.isPush = rng() % 2 == 0;
+                    op.invoked = clock.fetch_add(1);
+                    if (op.isPush) {
+                        op.value = makeTag(t, k);
+                        op.ok = queue.tryPush(op.value);
+                    } else {
+                        op.ok = queue.tryPop(op.value);
+                    }
+                    op.responded = clock.fetch_add(1);
+                    perThread[t].push_back(op);
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+
+        vector<Operation> history;
+        for (const auto& ops : perThread) history.insert(history.end(), ops.begin(), ops.end());
+        if (!LinearizabilityChecker(history).check()) failures++;
+    }
+    cout << left << setw(16) << name << right << (failures == 0 ? "PASS" : "FAIL") << "  " << trials - failures
+         << "/" << trials << " histories linearizable" << endl;
+    return failures;
+}
+
+/**
+ * A hand-written history that must be rejected: two sequential pushes popped out of order
+ */
+static bool checkerRejectsReorder() {
+    vector<Operation> history = {
+        {true, 1, true, 0, 1},
+        {true, 2, true, 2, 3},
+        {false, 2, true, 4, 5},
+    };
+    return !LinearizabilityChecker(history).check();
+}
+
+/**
+ * A rejected push (bounded queue full) must not be modelled as an insert
+ */
+static bool checkerAcceptsRejectedPush() {
+    vector<Operation> history = {
+        {true, 1, false, 0, 1},
+        {false, 0, false, 2, 3},
+    };
+    return LinearizabilityChecker(history).check();
+}
+
+/**
+ * Main function - usage: queue_stress [seed]
+ */
+int main(int argc, char** argv) {
+    unsigned seed = argc > 1 ? (unsigned)strtoul(argv[1], nullptr, 10) : 1;
+    cout << "=== Concurrent Queue Stress & Linearizability Harness (seed " << seed << ") ===" << endl;
+
+    cout << "\n--- Checker Self-Test ---" << endl;
+    cout << "Out-of-order pop rejected: " << (checkerRejectsReorder() ? "yes" : "NO") << endl;
+    cout << "Rejected push then empty pop accepted: " << (checkerAcceptsRejectedPush() ? "yes" : "NO") << endl;
+
+    StressConfig config;
+    config.seed = seed;
+
+    cout << "\n--- Stress: " << config.producers << " producers x " << config.itemsPerProducer << " items, "
+         << config.consumers << " consumers ---" << endl;
+    bool lockedOk = stressTest<LockedQueue>("LockedQueue", config).passed();
+    bool lockFreeOk = stressTest<LockFreeQueue>("LockFreeQueue", config).passed();
+    stressTest<RandomLaneQueue>("RandomLaneQueue", config);   // Expected to FAIL
+
+    cout << "\n--- Linearizability: random 12-op histories ---" << endl;
+    lockedOk &= linearizabilityTest<LockedQueue>("LockedQueue", 300, seed) == 0;
+    lockFreeOk &= linearizabilityTest<LockFreeQueue>("LockFreeQueue", 300, seed) == 0;
+    linearizabilityTest<RandomLaneQueue>("RandomLaneQueue", 300, seed);   // Expected to FAIL (most seeds)
+
+    cout << "\nVerdict: LockedQueue " << (lockedOk ? "trusted" : "BROKEN") << ", LockFreeQueue "
+         << (lockFreeOk ? "trusted" : "BROKEN") << ", RandomLaneQueue is the negative control" << endl;
+    return lockedOk && lockFreeOk ? 0 : 1;
+}
@@ -0,0 +1,321 @@
+/*
+ * Sharded (Multi-Lane) Queue
+ *
+ * A single head/tail pair guarded by one lock becomes the bottleneck once more
+ * than a few cores push and pop at the same time. ShardedQueue splits the queue
+ * into independent lanes (one per core by default):
+ *
+ * - Producers push into their own lane, picked once per thread
+ * - Consumers drain their home lane first, then walk the other lanes round-robin
+ *   and steal from the first one that has work
+ * - Each lane has its own lock and sits on its own cache line, so threads that
+ *   stay on their lanes never touch shared state
+ *
+ * Ordering guarantee: per-producer FIFO. Items from one producer thread are
+ * dequeued in the order they were pushed; there is no global order across producers.
+ *
+ * Operations to support:
+ * - push(T x): Appends x to the calling thread's lane
+ * - tryPop(T& out): Removes an item from the home lane or steals one, false if all lanes are empty
+ * - approxSize(): Sum of lane sizes, may be stale while other threads are active
+ */
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+// ----------- Node Class (Single Linked List Node) ------------
+template <typename T>
+class LinkedList {
+public:
+    T val;               // Stores the data of the node
+    LinkedList* next;    // Pointer to the next node
+
+    explicit LinkedList(const T& data) : val(data), next(nullptr) {}
+};
+
+// ----------- Lane: one lock-protected FIFO on its own cache line ------------
+template <typename T>
+struct alignas(64) Lane {
+    mutex lock;
+    LinkedList<T>* frontNode = nullptr;
+    LinkedList<T>* rearNode = nullptr;
+    size_t count = 0;
+
+    void pushLocked(const T& data) {
+        LinkedList<T>* newNode = new LinkedList<T>(data);
+        if (rearNode == nullptr) {
+            frontNode = rearNode = newNode;
+        } else {
+            rearNode->next = newNode;
+            rearNode = newNode;
+        }
+        count++;
+    }
+
+    bool popLocked(T& out) {
+        if (frontNode == nullptr) return false;
+        LinkedList<T>* temp = frontNode;
+        out = temp->val;
+        frontNode = frontNode->next;
+        if (frontNode == nullptr) rearNode = nullptr;
+        delete temp;
+        count--;
+        return true;
+    }
+
+    ~Lane() {
+        while (frontNode != nullptr) {
+            LinkedList<T>* temp = frontNode;
+            frontNode = frontNode->next;
+            delete temp;
+        }
+    }
+};
+
+// ----------- Sharded Queue ------------
+template <typename T>
+class ShardedQueue {
+private:
+    unique_ptr<Lane<T>[]> lanes;
+    size_t laneCount;
+    uint64_t instanceId;   // Mixed into the lane choice so threads do not collide in every queue alike
+
+    static uint64_t newInstanceId() {
+        static atomic<uint64_t> counter(0);
+        return counter.fetch_add(1, memory_order_relaxed) + 1;
+    }
+
+    // splitmix64 finalizer: spreads consecutive inputs over all lanes
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * Returns the calling thread's home lane in this queue: a hash of the thread
+     * and the queue, so it never changes for the queue's whole life, which is
+     * what makes per-producer FIFO hold. Nothing is stored per queue, so a
+     * thread that uses many short-lived queues keeps no state for them; a
+     * one-entry cache skips the hash on the common path.
+     */
+    size_t homeLane() {
+        static atomic<uint64_t> nextThread(0);
+        struct LastUsed {
+            uint64_t queue = 0;
+            size_t lane = 0;
+        };
+        thread_local const uint64_t threadToken = nextThread.fetch_add(1, memory_order_relaxed);
+        thread_local LastUsed last;
+        if (last.queue != instanceId) {
+            last.queue = instanceId;
+            last.lane = mix(threadToken * 0x9E3779B97F4A7C15ULL + instanceId) % laneCount;
+        }
+        return last.lane;
+    }
+
+public:
+    /**
+     * Constructor
+     * @param lanesWanted Number of lanes; 0 uses the hardware thread count
+     */
+    explicit ShardedQueue(size_t lanesWanted = 0) {
+        laneCount = lanesWanted ? lanesWanted : max(1u, thread::hardware_concurrency());
+        lanes.reset(new Lane<T>[laneCount]);
+        instanceId = newInstanceId();
+    }
+
+    ShardedQueue(const ShardedQueue&) = delete;
+    ShardedQueue& operator=(const ShardedQueue&) = delete;
+
+    /**
+     * Appends an item to the calling thread's lane
+     * @param data The item to enqueue
+     */
+    void push(const T& data) {
+        Lane<T>& lane = lanes[homeLane()];
+        lock_guard<mutex> guard(lane.lock);
+        lane.pushLocked(data);
+    }
+
+    /**
+     * Pops from the home lane, otherwise steals from the next non-empty lane.
+     * Busy lanes are skipped with try_lock on the first pass so a consumer does
+     * not queue up behind another one; the second pass waits for each lock.
+     * @param out Receives the dequeued item
+     * @return true if an item was dequeued, false if every lane was empty
+     */
+    bool tryPop(T& out) {
+        size_t home = homeLane();
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < laneCount; i++) {
+                Lane<T>& lane = lanes[(home + i) % laneCount];
+                unique_lock<mutex> guard(lane.lock, defer_lock);
+                if (pass == 0) {
+                    if (!guard.try_lock()) continue;
+                } else {
+                    guard.lock();
+                }
+                if (lane.popLocked(out)) return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Pushes into a specific lane, e.g. when producers are pinned to cores
+     */
+    void pushToLane(size_t laneIndex, const T& data) {
+        Lane<T>& lane = lanes[laneIndex % laneCount];
+        lock_guard<mutex> guard(lane.lock);
+        lane.pushLocked(data);
+    }
+
+    /**
+     * Returns the total number of queued items; exact only when the queue is quiescent
+     */
+    size_t approxSize() {
+        size_t total = 0;
+        for (size_t i = 0; i < laneCount; i++) {
+            lock_guard<mutex> guard(lanes[i].lock);
+            total += lanes[i].count;
+        }
+        return total;
+    }
+
+    size_t lanesUsed() const {
+        return laneCount;
+    }
+};
+
+// ----------- Single-lock baseline for comparison ------------
+template <typename T>
+class LockedQueue {
+    Lane<T> lane;
+public:
+    void push(const T& data) {
+        lock_guard<mutex> guard(lane.lock);
+        lane.pushLocked(data);
+    }
+    bool tryPop(T& out) {
+        lock_guard<mutex> guard(lane.lock);
+        return lane.popLocked(out);
+    }
+};
+
+// Encodes (producer, sequence) into one value so consumers can check ordering
+static long long encodeItem(int producer, long long seq) {
+    return ((long long)producer << 40) | seq;
+}
+
+/**
+ * Runs P producers and P consumers and returns million operations per second.
+ * When checkOrder is true, every popped item is recorded and checked afterwards:
+ * each (producer, sequence) must arrive exactly once, in per-producer order.
+ */
+template <typename Q>
+double runWorkload(Q& q, int threads, long long perProducer, bool checkOrder) {
+    atomic<int> producersLeft(threads);
+    long long expected = perProducer * threads;
+    vector<vector<long long>> popped(threads);   // What each consumer got, in order
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int p = 0; p < threads; p++) {
+        workers.emplace_back([&, p]() {
+            for (long long i = 0; i < perProducer; i++) q.push(encodeItem(p, i));
+            producersLeft.fetch_sub(1, memory_order_release);
+        });
+    }
+    for (int c = 0; c < threads; c++) {
+        workers.emplace_back([&, c]() {
+            vector<long long>& mine = popped[c];
+            long long item;
+            // Stops on the first empty pop after all producers finished, so a
+            // lost item shows up in the check below instead of hanging the run
+            while (true) {
+                bool producersDone = producersLeft.load(memory_order_acquire) == 0;
+                if (q.tryPop(item)) {
+                    if (checkOrder) mine.push_back(item);
+                } else if (producersDone) {
+                    break;
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+    auto end = chrono::steady_clock::now();
+
+    if (checkOrder) {
+        vector<vector<char>> seen(threads, vector<char>(perProducer, 0));
+        long long duplicated = 0, lost = 0;
+        bool orderOk = true;
+        for (const auto& mine : popped) {
+            vector<long long> lastSeen(threads, -1);   // Per consumer: FIFO holds within what it popped
+            for (long long tag : mine) {
+                int producer = (int)(tag >> 40);
+                long long seq = tag & ((1LL << 40) - 1);
+                if (producer < 0 || producer >= threads || seq >= perProducer || seen[producer][seq]++) {
+                    duplicated++;   // A value nobody pushed counts as corruption
+                    continue;
+                }
+                if (seq <= lastSeen[producer]) orderOk = false;
+                lastSeen[producer] = seq;
+            }
+        }
+        for (const auto& row : seen) {
+            for (char hit : row) lost += hit == 0;
+        }
+        cout << "  expected " << expected << " | lost " << lost << ", duplicated " << duplicated
+             << (orderOk ? " | per-producer FIFO ok" : " | ORDER VIOLATION") << endl;
+    }
+    double seconds = chrono::duration<double>(end - start).count();
+    return expected * 2 / seconds / 1e6;
+}
+
+/**
+ * Main function - correctness check and scaling comparison
+ */
+int main() {
+    cout << "=== Sharded Queue Demo ===" << endl;
+
+    // Basic single-threaded behaviour
+    cout << "\n--- Single Thread ---" << endl;
+    ShardedQueue<int> q(4);
+    for (int i = 1; i <= 3; i++) q.push(i * 10);
+    cout << "Size: " << q.approxSize() << endl;  // Should print 3
+    int value;
+    while (q.tryPop(value)) cout << "Pop: " << value << endl;  // 10, 20, 30
+    cout << "Pop on empty: " << (q.tryPop(value) ? "item" : "empty") << endl;
+
+    // Correctness under concurrency
+    cout << "\n--- Per-Producer FIFO Check (4 producers, 4 consumers) ---" << endl;
+    {
+        ShardedQueue<long long> sq(4);
+        runWorkload(sq, 4, 200000, true);
+    }
+
+    // Scaling vs single lock
+    cout << "\n--- Throughput (Mops/s, P producers + P consumers) ---" << endl;
+    unsigned hw = max(1u, thread::hardware_concurrency());
+    for (int threads = 1; threads <= (int)hw && threads <= 16; threads *= 2) {
+        LockedQueue<long long> locked;
+        ShardedQueue<long long> sharded(threads * 2);
+        double lockedOps = runWorkload(locked, threads, 200000, false);
+        double shardedOps = runWorkload(sharded, threads, 200000, false);
+        cout << "  threads=" << threads << " | single-lock: " << lockedOps
+             << " | sharded: " << shardedOps << endl;
+    }
+
+    return 0;
+}
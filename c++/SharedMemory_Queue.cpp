@@ -0,0 +1,597 @@
+/*
+ * Shared-Memory Inter-Process Queue
+ *
+ * Lets producers and consumers live in separate processes without sockets. The
+ * whole queue (header + slots) lives in one POSIX shared-memory segment that every
+ * process maps, possibly at a different address. Because of that it stores no
+ * pointers at all (unlike Queue's LinkedList* chain): a position is a 64-bit
+ * counter and slot i lives at byte offset  slotsOffset + (pos & mask) * slotStride.
+ *
+ * Modes (chosen by the creator, stored in the segment):
+ * - SPSC: one producer process, one consumer process; head/tail counters only
+ * - MPMC: any number of both; bounded ring with a per-slot state word
+ *
+ * Crashed peers:
+ * - SPSC: each role records its pid. A new process may take over a role only when
+ *   the recorded pid is dead, so a restarted producer/consumer resumes where the
+ *   old one stopped. A consumer that dies between reading and releasing a message
+ *   sees it again after restart (at-least-once).
+ * - MPMC: a slot is claimed by CAS-ing the claimer's pid into its state word before
+ *   the shared position moves. If another process finds a slot stuck in a claim
+ *   whose pid no longer exists, it repairs the slot: an unfinished push becomes a
+ *   tombstone that consumers skip, and an unfinished pop releases the slot
+ *   (that message is lost). Processes that are only slow are never touched.
+ *
+ * Build: g++ -std=c++17 -O2 SharedMemory_Queue.cpp  (add -lrt on glibc < 2.34)
+ */
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+enum class ShmMode : uint32_t {
+    SPSC = 1,
+    MPMC = 2
+};
+
+enum class ShmRole {
+    PRODUCER,
+    CONSUMER
+};
+
+class ShmQueue {
+private:
+    static const uint32_t MAGIC = 0x51554555;   // "QUEU"
+    static const uint32_t VERSION = 1;
+    static const uint32_t FLAG_TOMBSTONE = 1;
+
+    // Lock-free atomics are address-free, so they work across processes
+    static_assert(atomic<uint64_t>::is_always_lock_free, "shared-memory queue needs lock-free 64-bit atomics");
+
+    // Segment header; every field is placed by offset, never by pointer
+    struct ShmHeader {
+        uint32_t magic;
+        uint32_t version;
+        ShmMode mode;
+        uint32_t capacity;        // Slots, power of two
+        uint32_t slotPayload;     // Max message bytes per slot
+        uint32_t slotStride;      // Bytes between consecutive slots
+        uint64_t slotsOffset;     // Byte offset of slot 0 from the segment start
+        atomic<uint32_t> ready;   // Set last by the creator
+
+        alignas(64) atomic<uint64_t> enqueuePos;   // SPSC tail / MPMC next push
+        alignas(64) atomic<uint64_t> dequeuePos;   // SPSC head / MPMC next pop
+        alignas(64) atomic<int32_t> producerPid;   // SPSC role owners
+        atomic<int32_t> consumerPid;
+    };
+
+    struct SlotHeader {
+        atomic<uint64_t> state;   // MPMC: [claimer pid : 32][sequence : 32]
+        atomic<uint32_t> flags;
+        atomic<uint32_t> length;   // Atomic so a consumer may peek at it before claiming
+    };
+
+    string name;
+    uint8_t* base = nullptr;
+    size_t mappedBytes = 0;
+    ShmHeader* header = nullptr;
+    uint64_t mask = 0;
+    int32_t selfPid;
+    uint64_t cachedOther = 0;  // SPSC: last head (producer) or tail (consumer) seen
+
+    ShmQueue(const string& shmName, uint8_t* mapping, size_t bytes)
+        : name(shmName), base(mapping), mappedBytes(bytes),
+          header(reinterpret_cast<ShmHeader*>(mapping)), selfPid((int32_t)getpid()) {
+        mask = header->capacity - 1;
+    }
+
+    SlotHeader* slotAt(uint64_t pos) const {
+        return reinterpret_cast<SlotHeader*>(base + header->slotsOffset + (pos & mask) * header->slotStride);
+    }
+
+    static uint8_t* payloadOf(SlotHeader* slot) {
+        return reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader);
+    }
+
+    static uint64_t makeState(uint32_t seq, int32_t pid) {
+        return ((uint64_t)(uint32_t)pid << 32) | seq;
+    }
+    static uint32_t seqOf(uint64_t state) { return (uint32_t)state; }
+    static int32_t pidOf(uint64_t state) { return (int32_t)(state >> 32); }
+
+    /**
+     * A pid counts as dead only when the kernel says so; EPERM means it exists.
+     * Zombies still count as alive until their parent reaps them.
+     */
+    static bool processAlive(int32_t pid) {
+        if (pid <= 0) return false;
+        return kill(pid, 0) == 0 || errno == EPERM;
+    }
+
+    // ----------- SPSC ------------
+
+    bool spscPush(const void* data, uint32_t length) {
+        uint64_t tail = header->enqueuePos.load(memory_order_relaxed);
+        if (tail - cachedOther >= header->capacity) {
+            cachedOther = header->dequeuePos.load(memory_order_acquire);
+            if (tail - cachedOther >= header->capacity) return false;
+        }
+        SlotHeader* slot = slotAt(tail);
+        slot->length.store(length, memory_order_relaxed);
+        memcpy(payloadOf(slot), data, length);
+        header->enqueuePos.store(tail + 1, memory_order_release);
+        return true;
+    }
+
+    // want: exact message size the caller accepts, 0 for any; a mismatch stays queued
+    bool spscPop(void* out, uint32_t want, uint32_t& length) {
+        uint64_t head = header->dequeuePos.load(memory_order_relaxed);
+        if (head == cachedOther) {
+            cachedOther = header->enqueuePos.load(memory_order_acquire);
+            if (head == cachedOther) return false;
+        }
+        SlotHeader* slot = slotAt(head);
+        length = slot->length.load(memory_order_relaxed);
+        if (want != 0 && length != want) return false;
+        memcpy(out, payloadOf(slot), length);
+        header->dequeuePos.store(head + 1, memory_order_release);
+        return true;
+    }
+
+    // ----------- MPMC ------------
+
+    bool mpmcPush(const void* data, uint32_t length) {
+        uint64_t pos = header->enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            SlotHeader* slot = slotAt(pos);
+            uint64_t state = slot->state.load(memory_order_acquire);
+            int32_t diff = (int32_t)(seqOf(state) - (uint32_t)pos);
+            int32_t owner = pidOf(state);
+
+            if (diff == 0 && owner == 0) {
+                // Free for this lap: claim it with our pid, then move the position
+                if (!slot->state.compare_exchange_weak(state, makeState((uint32_t)pos, selfPid), memory_order_acq_rel)) {
+                    continue;
+                }
+                uint64_t expected = pos;   // CAS failure overwrites its argument; keep pos intact
+                header->enqueuePos.compare_exchange_strong(expected, pos + 1, memory_order_relaxed);
+                slot->length.store(length, memory_order_relaxed);
+                slot->flags.store(0, memory_order_relaxed);
+                memcpy(payloadOf(slot), data, length);
+                slot->state.store(makeState((uint32_t)pos + 1, 0), memory_order_release);
+                return true;
+            }
+            if (diff == 0) {
+                // Claimed by another producer: help advance, repair if it died
+                header->enqueuePos.compare_exchange_strong(pos, pos + 1, memory_order_relaxed);
+                if (!processAlive(owner)) repairProducerClaim(slot, state);
+                pos = header->enqueuePos.load(memory_order_relaxed);
+            } else if (diff < 0) {
+                // Previous lap not consumed yet; maybe held by a dead consumer. A dead
+                // producer's claim from that lap is left to consumers to tombstone.
+                if (seqOf(state) == (uint32_t)(pos - header->capacity + 1) && owner != 0 && !processAlive(owner)) {
+                    repairConsumerClaim(slot, state);
+                    continue;
+                }
+                return false;   // Full
+            } else {
+                pos = header->enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool mpmcPop(void* out, uint32_t want, uint32_t& length) {
+        uint64_t pos = header->dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            SlotHeader* slot = slotAt(pos);
+            uint64_t state = slot->state.load(memory_order_acquire);
+            int32_t diff = (int32_t)(seqOf(state) - (uint32_t)(pos + 1));
+            int32_t owner = pidOf(state);
+
+            if (diff == 0 && owner == 0) {
+                if (want != 0 && !(slot->flags.load(memory_order_relaxed) & FLAG_TOMBSTONE)) {
+                    // Peek at the size before claiming; the state re-check proves it
+                    // belongs to this message and not to a later lap
+                    uint32_t queued = slot->length.load(memory_order_relaxed);
+                    atomic_thread_fence(memory_order_acquire);
+                    if (slot->state.load(memory_order_relaxed) != state) continue;
+                    if (queued != want) {
+                        length = queued;
+                        return false;
+                    }
+                }
+                if (!slot->state.compare_exchange_weak(state, makeState((uint32_t)pos + 1, selfPid), memory_order_acq_rel)) {
+                    continue;
+                }
+                uint64_t expected = pos;
+                header->dequeuePos.compare_exchange_strong(expected, pos + 1, memory_order_relaxed);
+                bool tombstone = slot->flags.load(memory_order_relaxed) & FLAG_TOMBSTONE;
+                if (!tombstone) {
+                    length = slot->length.load(memory_order_relaxed);
+                    memcpy(out, payloadOf(slot), length);
+                }
+                slot->state.store(makeState((uint32_t)pos + header->capacity, 0), memory_order_release);
+                if (!tombstone) return true;
+                pos = header->dequeuePos.load(memory_order_relaxed);
+            } else if (diff == 0) {
+                // Claimed by another consumer
+                header->dequeuePos.compare_exchange_strong(pos, pos + 1, memory_order_relaxed);
+                if (!processAlive(owner)) repairConsumerClaim(slot, state);
+                pos = header->dequeuePos.load(memory_order_relaxed);
+            } else if (diff < 0) {
+                // Not published yet; maybe a producer died half way through
+                if (seqOf(state) == (uint32_t)pos && owner != 0 && !processAlive(owner)) {
+                    repairProducerClaim(slot, state);
+                    continue;
+                }
+                return false;   // Empty
+            } else {
+                pos = header->dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Publishes a dead producer's slot as a tombstone so consumers can move past it.
+     * The claim is taken over first, so only the repairer that wins it writes the
+     * flag, and only on this generation of the slot. If the repairer dies too, its
+     * own pid is now the dead owner and the next one repeats the repair.
+     */
+    void repairProducerClaim(SlotHeader* slot, uint64_t state) {
+        uint32_t seq = seqOf(state);
+        if (!slot->state.compare_exchange_strong(state, makeState(seq, selfPid), memory_order_acq_rel)) return;
+        slot->flags.store(FLAG_TOMBSTONE, memory_order_relaxed);
+        slot->state.store(makeState(seq + 1, 0), memory_order_release);
+    }
+
+    // Releases a slot a dead consumer had claimed; its message is lost
+    void repairConsumerClaim(SlotHeader* slot, uint64_t state) {
+        uint32_t pos = seqOf(state) - 1;
+        slot->state.compare_exchange_strong(state, makeState(pos + header->capacity, 0), memory_order_acq_rel);
+    }
+
+public:
+    ShmQueue(const ShmQueue&) = delete;
+    ShmQueue& operator=(const ShmQueue&) = delete;
+
+    /**
+     * Creates and initializes a new segment; fails if the name already exists
+     * @param shmName POSIX shm name, e.g. "/orders"
+     * @param mode SPSC or MPMC
+     * @param capacity Number of slots (rounded up to a power of two)
+     * @param slotPayload Maximum message size in bytes
+     * @return The queue, or nullptr on error
+     */
+    static unique_ptr<ShmQueue> create(const string& shmName, ShmMode mode, uint32_t capacity, uint32_t slotPayload) {
+        uint32_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        uint32_t stride = (uint32_t)((sizeof(SlotHeader) + slotPayload + 63) & ~(size_t)63);
+        uint64_t slotsOffset = (sizeof(ShmHeader) + 63) & ~(size_t)63;
+        size_t bytes = slotsOffset + (size_t)cap * stride;
+
+        int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            cout << "Error: shm_open(" << shmName << ") failed: " << strerror(errno) << endl;
+            return nullptr;
+        }
+        if (ftruncate(fd, (off_t)bytes) != 0) {
+            cout << "Error: ftruncate failed: " << strerror(errno) << endl;
+            close(fd);
+            shm_unlink(shmName.c_str());
+            return nullptr;
+        }
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            cout << "Error: mmap failed: " << strerror(errno) << endl;
+            shm_unlink(shmName.c_str());
+            return nullptr;
+        }
+
+        uint8_t* raw = static_cast<uint8_t*>(mapping);
+        ShmHeader* h = new (raw) ShmHeader();
+        h->magic = MAGIC;
+        h->version = VERSION;
+        h->mode = mode;
+        h->capacity = cap;
+        h->slotPayload = slotPayload;
+        h->slotStride = stride;
+        h->slotsOffset = slotsOffset;
+        h->enqueuePos.store(0, memory_order_relaxed);
+        h->dequeuePos.store(0, memory_order_relaxed);
+        h->producerPid.store(0, memory_order_relaxed);
+        h->consumerPid.store(0, memory_order_relaxed);
+        for (uint32_t i = 0; i < cap; i++) {
+            SlotHeader* slot = new (raw + slotsOffset + (size_t)i * stride) SlotHeader();
+            slot->state.store(makeState(i, 0), memory_order_relaxed);
+            slot->flags.store(0, memory_order_relaxed);
+            slot->length.store(0, memory_order_relaxed);
+        }
+        h->ready.store(1, memory_order_release);
+        return unique_ptr<ShmQueue>(new ShmQueue(shmName, raw, bytes));
+    }
+
+    /**
+     * Maps an existing segment created by another process
+     * @param shmName POSIX shm name used by create()
+     * @return The queue, or nullptr if missing, not yet initialized or incompatible
+     */
+    static unique_ptr<ShmQueue> attach(const string& shmName) {
+        int fd = shm_open(shmName.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            cout << "Error: shm_open(" << shmName << ") failed: " << strerror(errno) << endl;
+            return nullptr;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(ShmHeader)) {
+            cout << "Error: segment " << shmName << " is not initialized" << endl;
+            close(fd);
+            return nullptr;
+        }
+        size_t bytes = (size_t)info.st_size;
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            cout << "Error: mmap failed: " << strerror(errno) << endl;
+            return nullptr;
+        }
+        ShmHeader* h = static_cast<ShmHeader*>(mapping);
+        if (h->ready.load(memory_order_acquire) != 1 || h->magic != MAGIC || h->version != VERSION ||
+            h->slotsOffset + (uint64_t)h->capacity * h->slotStride > bytes) {
+            cout << "Error: segment " << shmName << " has an incompatible layout" << endl;
+            munmap(mapping, bytes);
+            return nullptr;
+        }
+        return unique_ptr<ShmQueue>(new ShmQueue(shmName, static_cast<uint8_t*>(mapping), bytes));
+    }
+
+    /**
+     * Removes the segment name; mappings stay valid until every process unmaps
+     */
+    static void destroy(const string& shmName) {
+        shm_unlink(shmName.c_str());
+    }
+
+    /**
+     * Claims the producer or consumer role of an SPSC queue. Succeeds when the
+     * role is free or its previous owner has died (takeover after a crash).
+     * @return false if a live process already owns the role or the queue is MPMC
+     */
+    bool registerRole(ShmRole role) {
+        if (header->mode != ShmMode::SPSC) return false;
+        atomic<int32_t>& owner = (role == ShmRole::PRODUCER) ? header->producerPid : header->consumerPid;
+        int32_t current = owner.load(memory_order_acquire);
+        while (current == 0 || current == selfPid || !processAlive(current)) {
+            if (owner.compare_exchange_weak(current, selfPid, memory_order_acq_rel)) {
+                cachedOther = (role == ShmRole::PRODUCER) ? header->dequeuePos.load(memory_order_acquire)
+                                                          : header->enqueuePos.load(memory_order_acquire);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Copies a message into the queue
+     * @return false if the queue is full or the message exceeds maxMessageSize()
+     */
+    bool tryPush(const void* data, uint32_t length) {
+        if (length > header->slotPayload) return false;
+        return header->mode == ShmMode::SPSC ? spscPush(data, length) : mpmcPush(data, length);
+    }
+
+    /**
+     * Copies the front message out of the queue
+     * @param out Buffer of at least maxMessageSize() bytes
+     * @param length Receives the message size
+     * @return false if the queue is empty
+     */
+    bool tryPop(void* out, uint32_t& length) {
+        return header->mode == ShmMode::SPSC ? spscPop(out, 0, length) : mpmcPop(out, 0, length);
+    }
+
+    bool tryPush(int value) {
+        return tryPush(&value, sizeof(value));
+    }
+
+    /**
+     * Pops the front message as an int
+     * @return false if the queue is empty or the front message is not int-sized;
+     *         such a message stays queued for tryPop(void*, uint32_t&)
+     */
+    bool tryPop(int& value) {
+        uint32_t length = 0;
+        return header->mode == ShmMode::SPSC ? spscPop(&value, sizeof(int), length)
+                                              : mpmcPop(&value, sizeof(int), length);
+    }
+
+    uint32_t maxMessageSize() const { return header->slotPayload; }
+    uint32_t capacity() const { return header->capacity; }
+    ShmMode mode() const { return header->mode; }
+
+    /**
+     * Approximate number of queued messages
+     */
+    size_t size() const {
+        uint64_t head = header->dequeuePos.load(memory_order_acquire);
+        uint64_t tail = header->enqueuePos.load(memory_order_acquire);
+        return tail > head ? (size_t)(tail - head) : 0;
+    }
+
+    /**
+     * Test hook: claims an MPMC slot the way push() does and stops there,
+     * leaving exactly the state a producer crashing mid-push would leave
+     */
+    bool debugClaimAndAbandon() {
+        if (header->mode != ShmMode::MPMC) return false;
+        uint64_t pos = header->enqueuePos.load(memory_order_relaxed);
+        SlotHeader* slot = slotAt(pos);
+        uint64_t state = slot->state.load(memory_order_acquire);
+        if (seqOf(state) != (uint32_t)pos || pidOf(state) != 0) return false;
+        if (!slot->state.compare_exchange_strong(state, makeState((uint32_t)pos, selfPid))) return false;
+        header->enqueuePos.compare_exchange_strong(pos, pos + 1);
+        return true;
+    }
+
+    ~ShmQueue() {
+        if (base != nullptr) munmap(base, mappedBytes);
+    }
+};
+
+// ----------- Demo helpers ------------
+
+static void spinUntil(const function<bool()>& condition) {
+    int spins = 0;
+    while (!condition()) {
+        if (++spins > 100) {
+            this_thread::yield();
+            spins = 0;
+        }
+    }
+}
+
+/**
+ * Main function - ping-pong latency, multi-process MPMC and crash recovery
+ */
+int main() {
+    cout << "=== Shared-Memory Queue Demo ===" << endl;
+
+    // Ping-pong between two processes over a pair of SPSC queues
+    cout << "\n--- SPSC Cross-Process Handoff Latency ---" << endl;
+    {
+        const string pingName = "/oop_demo_ping", pongName = "/oop_demo_pong";
+        ShmQueue::destroy(pingName);
+        ShmQueue::destroy(pongName);
+        auto ping = ShmQueue::create(pingName, ShmMode::SPSC, 1024, 64);
+        auto pong = ShmQueue::create(pongName, ShmMode::SPSC, 1024, 64);
+        if (!ping || !pong) return 1;
+        const int rounds = 20000;
+
+        pid_t child = fork();
+        if (child == 0) {
+            auto in = ShmQueue::attach(pingName);
+            auto out = ShmQueue::attach(pongName);
+            if (!in || !out || !in->registerRole(ShmRole::CONSUMER) || !out->registerRole(ShmRole::PRODUCER)) _exit(1);
+            for (int i = 0; i < rounds; i++) {
+                int value = 0;
+                spinUntil([&]() { return in->tryPop(value); });
+                spinUntil([&]() { return out->tryPush(value + 1); });
+            }
+            _exit(0);
+        }
+
+        ping->registerRole(ShmRole::PRODUCER);
+        pong->registerRole(ShmRole::CONSUMER);
+        bool ok = true;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++) {
+            int reply = 0;
+            spinUntil([&]() { return ping->tryPush(i); });
+            spinUntil([&]() { return pong->tryPop(reply); });
+            if (reply != i + 1) ok = false;
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        waitpid(child, nullptr, 0);
+
+        cout << "Replies: " << (ok ? "ok" : "MISMATCH") << endl;
+        cout << "Round trip: " << ns / rounds << " ns | one-way handoff: " << ns / rounds / 2 << " ns" << endl;
+        cout << "Second producer registration: "
+             << (ping->registerRole(ShmRole::PRODUCER) ? "ok (same process)" : "rejected") << endl;
+        ShmQueue::destroy(pingName);
+        ShmQueue::destroy(pongName);
+    }
+
+    // Two producer processes, consumer in the parent
+    cout << "\n--- MPMC With Two Producer Processes ---" << endl;
+    {
+        const string qName = "/oop_demo_mpmc";
+        ShmQueue::destroy(qName);
+        auto q = ShmQueue::create(qName, ShmMode::MPMC, 256, 16);
+        if (!q) return 1;
+        const int perProducer = 100000;
+
+        vector<pid_t> children;
+        for (int p = 0; p < 2; p++) {
+            pid_t child = fork();
+            if (child == 0) {
+                auto mine = ShmQueue::attach(qName);
+                if (!mine) _exit(1);
+                for (int i = 0; i < perProducer; i++) {
+                    spinUntil([&]() { return mine->tryPush(p * perProducer + i); });
+                }
+                _exit(0);
+            }
+            children.push_back(child);
+        }
+
+        long long sum = 0;
+        vector<int> lastSeen(2, -1);
+        bool fifo = true;
+        for (int i = 0; i < 2 * perProducer; i++) {
+            int value = 0;
+            spinUntil([&]() { return q->tryPop(value); });
+            int producer = value / perProducer;
+            if (value % perProducer <= lastSeen[producer]) fifo = false;
+            lastSeen[producer] = value % perProducer;
+            sum += value;
+        }
+        for (pid_t child : children) waitpid(child, nullptr, 0);
+
+        long long expected = (long long)(2 * perProducer) * (2 * perProducer - 1) / 2;
+        cout << "Checksum: " << (sum == expected ? "ok" : "MISMATCH")
+             << " | per-producer FIFO: " << (fifo ? "ok" : "VIOLATED") << endl;
+        ShmQueue::destroy(qName);
+    }
+
+    // A producer dies after claiming a slot; the consumer repairs it and moves on
+    cout << "\n--- Crashed Producer Recovery ---" << endl;
+    {
+        const string qName = "/oop_demo_crash";
+        ShmQueue::destroy(qName);
+        auto q = ShmQueue::create(qName, ShmMode::MPMC, 8, 16);
+        if (!q) return 1;
+
+        pid_t child = fork();
+        if (child == 0) {
+            auto mine = ShmQueue::attach(qName);
+            _exit(mine && mine->debugClaimAndAbandon() ? 0 : 1);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);   // Reaped, so the pid now reads as dead
+        cout << "Child abandoned a claimed slot: " << (WEXITSTATUS(status) == 0 ? "yes" : "no") << endl;
+
+        q->tryPush(42);
+        int value = 0;
+        bool got = q->tryPop(value);
+        cout << "Pop after crash: " << (got ? to_string(value) : string("empty")) << endl;  // Should print 42
+        cout << "Queue empty afterwards: " << (q->tryPop(value) ? "no" : "yes") << endl;
+
+        // A message that is not an int is left in place for the byte-level pop
+        q->tryPush("abc", 3);
+        cout << "tryPop(int) on a 3-byte message: " << (q->tryPop(value) ? "popped" : "refused") << endl;
+        char text[16] = {0};
+        uint32_t length = 0;
+        bool raw = q->tryPop(text, length);
+        cout << "Byte pop: " << (raw ? string(text, length) : string("empty")) << endl;  // Should print abc
+        ShmQueue::destroy(qName);
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Compile-Time Fixed-Capacity Queue (no heap)
+ *
+ * Queue::push always calls new, which latency-critical paths cannot afford.
+ * StaticQueue<T, N> keeps its N elements inline:
+ *
+ * - No heap allocation, ever; the object is exactly its storage plus two indices
+ * - The index type is the smallest unsigned type that can hold N
+ *   (StaticQueue<char, 200> uses uint8_t indices and is 202 bytes)
+ * - Every operation is constexpr, so the queue works inside constant expressions
+ * - Wraparound uses a compare-and-select instead of %, and full/empty are single
+ *   comparisons, so the hot path compiles to (almost) branch-free code
+ * - Embeds directly in other objects (no indirection, trivially copyable when T is)
+ *
+ * Operations to support:
+ * - push(T x): Appends x, returns false when full
+ * - pop(T& out): Removes the front element, returns false when empty
+ * - front(): Returns the front element (the queue must not be empty)
+ * - size() / empty() / full() / capacity()
+ */
+
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+// ----------- Index type selection ------------
+/**
+ * Smallest unsigned integer type that can represent values 0..N
+ */
+template <size_t N>
+using SmallestIndex =
+    conditional_t<(N <= UINT8_MAX), uint8_t,
+    conditional_t<(N <= UINT16_MAX), uint16_t,
+    conditional_t<(N <= UINT32_MAX), uint32_t, uint64_t>>>;
+
+// ----------- Static Queue ------------
+template <typename T, size_t N>
+class StaticQueue {
+    static_assert(N > 0, "StaticQueue capacity must be positive");
+    static_assert(is_default_constructible<T>::value, "StaticQueue elements are stored inline and need a default constructor");
+
+public:
+    using IndexType = SmallestIndex<N>;
+
+private:
+    T items[N] {};          // Inline ring storage
+    IndexType head = 0;     // Index of the front element
+    IndexType count = 0;    // Number of stored elements
+
+    // Advances an index by one with wraparound; compiles to a cmov, not a division
+    static constexpr IndexType wrap(size_t index) {
+        return (IndexType)(index >= N ? index - N : index);
+    }
+
+public:
+    constexpr StaticQueue() = default;
+
+    /**
+     * Adds an element to the rear of the queue
+     * @param data The value to enqueue
+     * @return false if the queue is full
+     */
+    constexpr bool push(const T& data) {
+        if (count == N) return false;
+        items[wrap((size_t)head + count)] = data;
+        count++;
+        return true;
+    }
+
+    /**
+     * Removes the front element
+     * @param out Receives the dequeued value
+     * @return false if the queue is empty
+     */
+    constexpr bool pop(T& out) {
+        if (count == 0) return false;
+        out = items[head];
+        head = wrap((size_t)head + 1);
+        count--;
+        return true;
+    }
+
+    /**
+     * Returns the front element; calling this on an empty queue is a logic error
+     */
+    constexpr const T& front() const {
+        return items[head];
+    }
+
+    constexpr size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    constexpr bool full() const { return count == N; }
+    static constexpr size_t capacity() { return N; }
+
+    constexpr void clear() {
+        head = 0;
+        count = 0;
+    }
+};
+
+// ----------- Compile-time checks ------------
+
+static_assert(is_same<StaticQueue<int, 200>::IndexType, uint8_t>::value, "N <= 255 uses 8-bit indices");
+static_assert(is_same<StaticQueue<int, 1000>::IndexType, uint16_t>::value, "N <= 65535 uses 16-bit indices");
+static_assert(is_same<StaticQueue<int, 100000>::IndexType, uint32_t>::value, "larger N uses 32-bit indices");
+static_assert(sizeof(StaticQueue<char, 200>) == 202, "storage plus two 1-byte indices");
+
+/**
+ * Runs a FIFO sequence with wraparound entirely at compile time
+ * @return Sum of popped values weighted by pop order
+ */
+constexpr int compileTimeRoundTrip() {
+    StaticQueue<int, 3> q;
+    q.push(1);
+    q.push(2);
+    q.push(3);
+    bool overflowRejected = !q.push(4);
+    int value = 0, result = 0;
+    q.pop(value);                 // 1
+    result += value * 1;
+    q.push(4);                    // wraps to slot 0
+    for (int order = 2; q.pop(value); order++) result += value * order;  // 2, 3, 4
+    return overflowRejected ? result : -1;
+}
+
+static_assert(compileTimeRoundTrip() == 1 * 1 + 2 * 2 + 3 * 3 + 4 * 4, "constexpr FIFO with wraparound");
+
+// ----------- Embedding example ------------
+/**
+ * An order book level keeps its pending order ids inline: one allocation-free
+ * object, no pointer chase to reach the queue
+ */
+struct PriceLevel {
+    double price = 0.0;
+    StaticQueue<uint32_t, 64> orderIds;
+};
+
+/**
+ * Main function - demonstrates runtime use, error handling and embedding
+ */
+int main() {
+    cout << "=== Static Queue Demo ===" << endl;
+
+    cout << "\n--- Basic Operations ---" << endl;
+    StaticQueue<int, 4> q;
+    q.push(10);
+    q.push(20);
+    q.push(30);
+    cout << "Front: " << q.front() << endl;   // Should print 10
+    cout << "Size: " << q.size() << endl;     // Should print 3
+    int value = 0;
+    q.pop(value);
+    cout << "Pop: " << value << endl;         // Should print 10
+    cout << "Front: " << q.front() << endl;   // Should print 20
+
+    cout << "\n--- Full / Empty Handling ---" << endl;
+    q.push(40);
+    q.push(50);                               // Wraps around
+    cout << "Push when full: " << (q.push(60) ? "accepted" : "rejected") << endl;
+    while (q.pop(value)) cout << "Drain: " << value << endl;  // 20 30 40 50
+    cout << "Pop when empty: " << (q.pop(value) ? "item" : "empty") << endl;
+
+    cout << "\n--- Compile-Time Evaluation ---" << endl;
+    constexpr int folded = compileTimeRoundTrip();
+    cout << "Result computed by the compiler: " << folded << endl;  // Should print 30
+
+    cout << "\n--- Embedding ---" << endl;
+    PriceLevel level;
+    level.price = 101.25;
+    for (uint32_t id = 1; id <= 3; id++) level.orderIds.push(id);
+    cout << "sizeof(PriceLevel): " << sizeof(PriceLevel) << " bytes, "
+         << level.orderIds.size() << " orders queued at " << level.price << endl;
+    cout << "Index type size for N=64: " << sizeof(StaticQueue<uint32_t, 64>::IndexType) << " byte" << endl;
+
+    return 0;
+}
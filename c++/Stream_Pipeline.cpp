@@ -0,0 +1,811 @@
+/*
+ * Stream-Processing Pipeline
+ *
+ * Multi-stage processing (parse -> enrich -> filter -> sink) is a chain of
+ * queues with workers in between. Pipeline wires that chain up from a few
+ * declarative operators:
+ *
+ * - source / map / filter / batch / sink operators, chained with a builder
+ * - Each stage runs with N instances, either on dedicated threads or as tasks
+ *   on a shared worker pool
+ * - Stages are connected by bounded channels: a lock-free SPSC ring when both
+ *   sides have one instance, a mutex-based MPMC ring otherwise
+ * - Backpressure: a full channel blocks its producer (dedicated) or parks the
+ *   output until there is room (pooled), so memory stays bounded by capacity
+ * - Automatic batching: a stage takes everything available (up to maxBatch)
+ *   in one go and forwards its output as one batch, so batches are 1 item when
+ *   the pipeline is idle and grow by themselves when a downstream stage lags
+ * - Per-stage metrics: items in/out, average batch, throughput, batch latency
+ *   percentiles and time spent blocked by backpressure
+ *
+ * With more than one instance per stage, the output order is not preserved.
+ *
+ * Operations to support:
+ * - source<T>(name, generator): Starts a pipeline; generator returns false at end of stream
+ * - .map(name, f) / .filter(name, pred) / .batch(name, n) / .sink(name, f)
+ * - run(): Starts every stage and waits for the stream to drain
+ * - printMetrics(): Per-stage metrics table
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <cstdint>
+
+using namespace std;
+
+// ----------- Channels (bounded queues between stages) ------------
+
+template <typename T>
+class Channel {
+protected:
+    atomic<size_t> producersLeft;   // The channel closes when every upstream instance is done
+
+public:
+    explicit Channel(size_t producers) : producersLeft(producers) {}
+    virtual ~Channel() = default;
+
+    /**
+     * Moves up to n items in without blocking
+     * @return Number of items accepted
+     */
+    virtual size_t tryPush(T* items, size_t n) = 0;
+
+    /**
+     * Appends up to max items to out without blocking
+     * @return Number of items taken
+     */
+    virtual size_t tryPop(vector<T>& out, size_t max) = 0;
+
+    /**
+     * Moves all items in, blocking while the channel is full (backpressure)
+     */
+    virtual void push(T* items, size_t n) = 0;
+
+    /**
+     * Blocks until at least one item is available
+     * @return false once the channel is closed and drained
+     */
+    virtual bool pop(vector<T>& out, size_t max) = 0;
+
+    virtual size_t size() const = 0;
+
+    virtual void producerDone() {
+        producersLeft.fetch_sub(1, memory_order_acq_rel);
+    }
+
+    bool closed() const { return producersLeft.load(memory_order_acquire) == 0; }
+    bool finished() const { return closed() && size() == 0; }
+};
+
+/**
+ * Lock-free single-producer single-consumer ring
+ */
+template <typename T>
+class SpscChannel : public Channel<T> {
+private:
+    vector<T> ring;
+    size_t mask;
+    alignas(64) atomic<size_t> head{0};   // Next slot to read (consumer)
+    alignas(64) atomic<size_t> tail{0};   // Next slot to write (producer)
+
+public:
+    explicit SpscChannel(size_t capacity) : Channel<T>(1) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        ring.resize(size);
+        mask = size - 1;
+    }
+
+    size_t tryPush(T* items, size_t n) override {
+        size_t t = tail.load(memory_order_relaxed);
+        size_t room = ring.size() - (t - head.load(memory_order_acquire));
+        size_t count = n < room ? n : room;
+        for (size_t i = 0; i < count; i++) ring[(t + i) & mask] = std::move(items[i]);
+        tail.store(t + count, memory_order_release);
+        return count;
+    }
+
+    size_t tryPop(vector<T>& out, size_t max) override {
+        size_t h = head.load(memory_order_relaxed);
+        size_t available = tail.load(memory_order_acquire) - h;
+        size_t count = max < available ? max : available;
+        for (size_t i = 0; i < count; i++) out.push_back(std::move(ring[(h + i) & mask]));
+        head.store(h + count, memory_order_release);
+        return count;
+    }
+
+    void push(T* items, size_t n) override {
+        size_t done = 0;
+        while (done < n) {
+            size_t pushed = tryPush(items + done, n - done);
+            if (pushed == 0) this_thread::yield();
+            done += pushed;
+        }
+    }
+
+    bool pop(vector<T>& out, size_t max) override {
+        while (true) {
+            if (tryPop(out, max) > 0) return true;
+            if (this->closed() && size() == 0) return false;
+            this_thread::yield();
+        }
+    }
+
+    size_t size() const override {
+        return tail.load(memory_order_acquire) - head.load(memory_order_acquire);
+    }
+};
+
+/**
+ * Multi-producer multi-consumer ring guarded by a mutex
+ */
+template <typename T>
+class MpmcChannel : public Channel<T> {
+private:
+    vector<T> ring;
+    size_t head = 0;
+    size_t count = 0;
+    mutable mutex lock;
+    condition_variable notFull;
+    condition_variable notEmpty;
+
+    size_t pushLocked(T* items, size_t n) {
+        size_t accepted = 0;
+        while (accepted < n && count < ring.size()) {
+            ring[(head + count) % ring.size()] = std::move(items[accepted++]);
+            count++;
+        }
+        return accepted;
+    }
+
+    size_t popLocked(vector<T>& out, size_t max) {
+        size_t taken = 0;
+        while (taken < max && count > 0) {
+            out.push_back(std::move(ring[head]));
+            head = (head + 1) % ring.size();
+            count--;
+            taken++;
+        }
+        return taken;
+    }
+
+public:
+    MpmcChannel(size_t capacity, size_t producers) : Channel<T>(producers), ring(capacity ? capacity : 1) {}
+
+    size_t tryPush(T* items, size_t n) override {
+        size_t accepted;
+        {
+            lock_guard<mutex> guard(lock);
+            accepted = pushLocked(items, n);
+        }
+        if (accepted > 0) notEmpty.notify_all();
+        return accepted;
+    }
+
+    size_t tryPop(vector<T>& out, size_t max) override {
+        size_t taken;
+        {
+            lock_guard<mutex> guard(lock);
+            taken = popLocked(out, max);
+        }
+        if (taken > 0) notFull.notify_all();
+        return taken;
+    }
+
+    void push(T* items, size_t n) override {
+        size_t done = 0;
+        unique_lock<mutex> guard(lock);
+        while (done < n) {
+            notFull.wait(guard, [&] { return count < ring.size(); });
+            done += pushLocked(items + done, n - done);
+            notEmpty.notify_all();
+        }
+    }
+
+    bool pop(vector<T>& out, size_t max) override {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [&] { return count > 0 || this->closed(); });
+        if (count == 0) return false;
+        popLocked(out, max);
+        guard.unlock();
+        notFull.notify_all();
+        return true;
+    }
+
+    size_t size() const override {
+        lock_guard<mutex> guard(lock);
+        return count;
+    }
+
+    void producerDone() override {
+        lock_guard<mutex> guard(lock);   // Waiters must not miss the close
+        Channel<T>::producerDone();
+        notEmpty.notify_all();
+    }
+};
+
+// ----------- Metrics ------------
+
+struct StageMetrics {
+    uint64_t itemsIn = 0;
+    uint64_t itemsOut = 0;
+    uint64_t batches = 0;
+    uint64_t busyNs = 0;                  // Time spent inside the operator
+    uint64_t blockedNs = 0;               // Time spent waiting for downstream room
+    uint64_t latencyHistogram[40] = {};   // Batch service time, bucket b covers [2^b, 2^(b+1)) ns
+
+    void recordBatch(uint64_t in, uint64_t out, uint64_t ns) {
+        itemsIn += in;
+        itemsOut += out;
+        batches++;
+        busyNs += ns;
+        int bucket = 0;
+        while (bucket < 39 && (ns >> (bucket + 1)) != 0) bucket++;
+        latencyHistogram[bucket]++;
+    }
+
+    void merge(const StageMetrics& other) {
+        itemsIn += other.itemsIn;
+        itemsOut += other.itemsOut;
+        batches += other.batches;
+        busyNs += other.busyNs;
+        blockedNs += other.blockedNs;
+        for (int i = 0; i < 40; i++) latencyHistogram[i] += other.latencyHistogram[i];
+    }
+
+    /**
+     * Upper bound of the bucket holding the given percentile of batch latencies
+     */
+    uint64_t latencyPercentileNs(double percentile) const {
+        uint64_t target = (uint64_t)(batches * percentile / 100.0);
+        uint64_t seen = 0;
+        for (int i = 0; i < 40; i++) {
+            seen += latencyHistogram[i];
+            if (seen > target) return 1ULL << (i + 1);
+        }
+        return 0;
+    }
+};
+
+static uint64_t nowNs() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ----------- Stage tasks ------------
+
+enum class Execution { Dedicated, Pooled };
+
+struct StageOptions {
+    size_t parallelism = 1;
+    Execution execution = Execution::Dedicated;
+    size_t maxBatch = 64;   // Largest batch a stage takes from its input at once
+};
+
+/**
+ * One instance of a stage, as the pipeline sees it
+ */
+class StageTask {
+public:
+    string name;
+    Execution execution;
+    StageMetrics metrics;
+    mutex busy;                  // A pooled task runs on one pool thread at a time
+    atomic<bool> done{false};
+
+    StageTask(const string& n, Execution e) : name(n), execution(e) {}
+    virtual ~StageTask() = default;
+
+    // Runs to the end of the stream, blocking on channels
+    virtual void runDedicated() = 0;
+
+    // Does one bounded, non-blocking unit of work; false if nothing could be done
+    virtual bool step() = 0;
+
+    // True if the stage emits items but no downstream stage was declared to receive them
+    virtual bool outputUnconnected() const { return false; }
+};
+
+// Where a stage writes; filled in when the next stage is declared
+template <typename T>
+struct OutputSlot {
+    shared_ptr<Channel<T>> channel;
+};
+
+/**
+ * Shared by operator and source tasks: output buffering and emission
+ */
+template <typename Out>
+class EmittingTask : public StageTask {
+protected:
+    shared_ptr<OutputSlot<Out>> output;   // Null for sinks
+    vector<Out> outBuffer;
+    size_t pendingPos = 0;                // First not-yet-pushed item in outBuffer (pooled mode)
+
+    // Dedicated mode: pushes the whole buffer, blocking on backpressure
+    void emitBlocking() {
+        if (output == nullptr || outBuffer.empty()) {
+            outBuffer.clear();
+            return;
+        }
+        uint64_t start = nowNs();
+        output->channel->push(outBuffer.data(), outBuffer.size());
+        metrics.blockedNs += nowNs() - start;
+        outBuffer.clear();
+    }
+
+    // Pooled mode: pushes what fits
+    // @return true if nothing is left pending
+    bool emitSome() {
+        if (output == nullptr) {
+            outBuffer.clear();
+            pendingPos = 0;
+            return true;
+        }
+        pendingPos += output->channel->tryPush(outBuffer.data() + pendingPos, outBuffer.size() - pendingPos);
+        if (pendingPos < outBuffer.size()) return false;
+        outBuffer.clear();
+        pendingPos = 0;
+        return true;
+    }
+
+    void closeOutput() {
+        if (output != nullptr) output->channel->producerDone();
+        done.store(true, memory_order_release);
+    }
+
+public:
+    EmittingTask(const string& n, Execution e, shared_ptr<OutputSlot<Out>> out)
+        : StageTask(n, e), output(out) {}
+
+    bool outputUnconnected() const override { return output != nullptr && output->channel == nullptr; }
+};
+
+// Per-instance operator: process turns a batch of In into Outs, flush runs at end of stream
+template <typename In, typename Out>
+struct Operator {
+    function<void(vector<In>&, vector<Out>&)> process;
+    function<void(vector<Out>&)> flush;
+};
+
+template <typename In, typename Out>
+class OperatorTask : public EmittingTask<Out> {
+private:
+    shared_ptr<Channel<In>> input;
+    Operator<In, Out> op;
+    size_t maxBatch;
+    vector<In> inBuffer;
+    bool flushed = false;
+
+    void processBatch() {
+        uint64_t start = nowNs();
+        size_t before = this->outBuffer.size();
+        op.process(inBuffer, this->outBuffer);
+        this->metrics.recordBatch(inBuffer.size(), this->outBuffer.size() - before, nowNs() - start);
+        inBuffer.clear();
+    }
+
+public:
+    OperatorTask(const string& n, Execution e, shared_ptr<Channel<In>> in, shared_ptr<OutputSlot<Out>> out,
+                 Operator<In, Out> o, size_t batch)
+        : EmittingTask<Out>(n, e, out), input(in), op(std::move(o)), maxBatch(batch) {
+        inBuffer.reserve(maxBatch);
+    }
+
+    void runDedicated() override {
+        while (input->pop(inBuffer, maxBatch)) {
+            processBatch();
+            this->emitBlocking();
+        }
+        if (op.flush) op.flush(this->outBuffer);
+        this->emitBlocking();
+        this->closeOutput();
+    }
+
+    bool step() override {
+        if (this->done.load(memory_order_acquire)) return false;
+        // Backpressure: no new input until the previous output has been handed on
+        if (!this->emitSome()) return false;
+        if (flushed) {
+            this->closeOutput();
+            return true;
+        }
+        if (input->tryPop(inBuffer, maxBatch) == 0) {
+            if (!input->finished()) return false;
+            if (op.flush) op.flush(this->outBuffer);
+            flushed = true;
+            if (this->emitSome()) this->closeOutput();
+            return true;
+        }
+        processBatch();
+        this->emitSome();
+        return true;
+    }
+};
+
+template <typename Out>
+class SourceTask : public EmittingTask<Out> {
+private:
+    function<bool(Out&)> generator;
+    size_t maxBatch;
+    bool exhausted = false;
+
+    // Pulls up to maxBatch items from the generator into outBuffer
+    void generate() {
+        uint64_t start = nowNs();
+        size_t produced = 0;
+        Out item{};
+        while (produced < maxBatch && generator(item)) {
+            this->outBuffer.push_back(std::move(item));
+            produced++;
+        }
+        if (produced < maxBatch) exhausted = true;
+        if (produced > 0) this->metrics.recordBatch(0, produced, nowNs() - start);
+    }
+
+public:
+    SourceTask(const string& n, Execution e, shared_ptr<OutputSlot<Out>> out, function<bool(Out&)> gen, size_t batch)
+        : EmittingTask<Out>(n, e, out), generator(std::move(gen)), maxBatch(batch) {}
+
+    void runDedicated() override {
+        while (!exhausted) {
+            generate();
+            this->emitBlocking();
+        }
+        this->closeOutput();
+    }
+
+    bool step() override {
+        if (this->done.load(memory_order_acquire)) return false;
+        if (!this->emitSome()) return false;
+        if (exhausted) {
+            this->closeOutput();
+            return true;
+        }
+        generate();
+        this->emitSome();
+        return true;
+    }
+};
+
+// ----------- Pipeline ------------
+
+template <typename T>
+class Stream;
+
+class Pipeline {
+private:
+    vector<unique_ptr<StageTask>> tasks;
+    size_t channelCapacity;
+    size_t poolThreads;
+    double wallSeconds = 0;
+
+    template <typename T>
+    friend class Stream;
+
+    void addTask(StageTask* task) { tasks.emplace_back(task); }
+
+    // Pool worker: sweeps the pooled tasks until all of them are done
+    void poolLoop(const vector<StageTask*>& pooled) {
+        while (true) {
+            bool progress = false, allDone = true;
+            for (StageTask* task : pooled) {
+                if (task->done.load(memory_order_acquire)) continue;
+                allDone = false;
+                unique_lock<mutex> lock(task->busy, try_to_lock);
+                if (!lock.owns_lock()) continue;
+                // A few steps per visit keeps a busy stage on a warm cache
+                for (int i = 0; i < 8 && task->step(); i++) progress = true;
+            }
+            if (allDone) return;
+            if (!progress) this_thread::yield();
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * @param capacity Items each inter-stage channel can buffer (the backpressure bound)
+     * @param threads Worker threads shared by all pooled stages
+     */
+    explicit Pipeline(size_t capacity = 1024, size_t threads = 2)
+        : channelCapacity(capacity), poolThreads(threads ? threads : 1) {}
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * Declares the first stage
+     * @param generator Writes the next item and returns true, or returns false at end of stream
+     */
+    template <typename T>
+    Stream<T> source(const string& name, function<bool(T&)> generator, size_t maxBatch = 64,
+                     Execution execution = Execution::Dedicated) {
+        auto slot = make_shared<OutputSlot<T>>();
+        addTask(new SourceTask<T>(name, execution, slot, std::move(generator), maxBatch));
+        return Stream<T>(this, slot, 1);
+    }
+
+    /**
+     * Starts every stage and blocks until the whole stream has been processed
+     * @return false, without starting anything, if the pipeline does not end in a sink
+     */
+    bool run() {
+        for (auto& task : tasks) {
+            if (task->outputUnconnected()) {
+                cout << "Error: stage " << task->name << " has no downstream stage; end the pipeline with sink()" << endl;
+                return false;
+            }
+        }
+        auto start = chrono::steady_clock::now();
+        vector<thread> threads;
+        vector<StageTask*> pooled;
+        for (auto& task : tasks) {
+            if (task->execution == Execution::Dedicated) {
+                StageTask* t = task.get();
+                threads.emplace_back([t] { t->runDedicated(); });
+            } else {
+                pooled.push_back(task.get());
+            }
+        }
+        if (!pooled.empty()) {
+            for (size_t i = 0; i < poolThreads; i++) threads.emplace_back([this, &pooled] { poolLoop(pooled); });
+        }
+        for (auto& t : threads) t.join();
+        wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    /**
+     * Prints one line per stage, merging the metrics of its instances
+     */
+    void printMetrics() const {
+        cout << left << setw(10) << "stage" << right << setw(5) << "inst" << setw(10) << "in" << setw(10) << "out"
+             << setw(10) << "avgBatch" << setw(12) << "items/s" << setw(10) << "p50(us)" << setw(10) << "p99(us)"
+             << setw(13) << "blocked(ms)" << endl;
+        size_t i = 0;
+        while (i < tasks.size()) {
+            StageMetrics total;
+            size_t instances = 0;
+            const string& name = tasks[i]->name;
+            for (; i < tasks.size() && tasks[i]->name == name; i++, instances++) total.merge(tasks[i]->metrics);
+            uint64_t items = total.itemsIn ? total.itemsIn : total.itemsOut;
+            cout << left << setw(10) << name << right << setw(5) << instances << setw(10) << total.itemsIn
+                 << setw(10) << total.itemsOut << setw(10) << fixed << setprecision(1)
+                 << (total.batches ? (double)items / total.batches : 0.0) << setw(12) << setprecision(0)
+                 << items / (wallSeconds > 0 ? wallSeconds : 1) << setw(10) << setprecision(1)
+                 << total.latencyPercentileNs(50) / 1000.0 << setw(10) << total.latencyPercentileNs(99) / 1000.0
+                 << setw(13) << total.blockedNs / 1e6 << endl;
+        }
+        cout << "wall time: " << setprecision(3) << wallSeconds * 1000 << " ms" << endl;
+        cout.unsetf(ios::fixed);
+    }
+};
+
+/**
+ * Builder handle for the output of the most recently declared stage
+ */
+template <typename T>
+class Stream {
+private:
+    Pipeline* pipeline;
+    shared_ptr<OutputSlot<T>> slot;   // Upstream writes here
+    size_t upstreamInstances;
+
+    friend class Pipeline;
+    template <typename U>
+    friend class Stream;
+
+    Stream(Pipeline* p, shared_ptr<OutputSlot<T>> s, size_t instances)
+        : pipeline(p), slot(s), upstreamInstances(instances) {}
+
+    // Connects the upstream to a new stage, picking the cheapest channel that is safe
+    shared_ptr<Channel<T>> connect(size_t downstreamInstances) {
+        if (upstreamInstances == 1 && downstreamInstances == 1) {
+            slot->channel = make_shared<SpscChannel<T>>(pipeline->channelCapacity);
+        } else {
+            slot->channel = make_shared<MpmcChannel<T>>(pipeline->channelCapacity, upstreamInstances);
+        }
+        return slot->channel;
+    }
+
+    // makeOperator() is called once per instance, so stateful operators are not shared
+    template <typename Out>
+    Stream<Out> addStage(const string& name, const StageOptions& options, function<Operator<T, Out>()> makeOperator,
+                         bool terminal) {
+        size_t instances = options.parallelism ? options.parallelism : 1;
+        shared_ptr<Channel<T>> input = connect(instances);
+        auto nextSlot = terminal ? nullptr : make_shared<OutputSlot<Out>>();
+        for (size_t i = 0; i < instances; i++) {
+            pipeline->addTask(new OperatorTask<T, Out>(name, options.execution, input, nextSlot, makeOperator(),
+                                                       options.maxBatch));
+        }
+        return Stream<Out>(pipeline, nextSlot, instances);
+    }
+
+public:
+    /**
+     * Transforms every item with f
+     */
+    template <typename F, typename Out = decay_t<invoke_result_t<F, T&>>>
+    Stream<Out> map(const string& name, F f, StageOptions options = {}) {
+        return addStage<Out>(name, options, [f]() {
+            Operator<T, Out> op;
+            op.process = [f](vector<T>& in, vector<Out>& out) {
+                for (T& item : in) out.push_back(f(item));
+            };
+            return op;
+        }, false);
+    }
+
+    /**
+     * Keeps only items for which pred returns true
+     */
+    template <typename F>
+    Stream<T> filter(const string& name, F pred, StageOptions options = {}) {
+        return addStage<T>(name, options, [pred]() {
+            Operator<T, T> op;
+            op.process = [pred](vector<T>& in, vector<T>& out) {
+                for (T& item : in) {
+                    if (pred(item)) out.push_back(std::move(item));
+                }
+            };
+            return op;
+        }, false);
+    }
+
+    /**
+     * Groups consecutive items into vectors of n (the last one may be shorter)
+     */
+    Stream<vector<T>> batch(const string& name, size_t n, StageOptions options = {}) {
+        if (n == 0) n = 1;
+        return addStage<vector<T>>(name, options, [n]() {
+            auto pending = make_shared<vector<T>>();
+            Operator<T, vector<T>> op;
+            op.process = [n, pending](vector<T>& in, vector<vector<T>>& out) {
+                for (T& item : in) {
+                    pending->push_back(std::move(item));
+                    if (pending->size() == n) {
+                        out.push_back(std::move(*pending));
+                        pending->clear();
+                    }
+                }
+            };
+            op.flush = [pending](vector<vector<T>>& out) {
+                if (!pending->empty()) out.push_back(std::move(*pending));
+                pending->clear();
+            };
+            return op;
+        }, false);
+    }
+
+    /**
+     * Terminal stage: calls f for every item
+     */
+    template <typename F>
+    void sink(const string& name, F f, StageOptions options = {}) {
+        addStage<int>(name, options, [f]() {
+            Operator<T, int> op;
+            op.process = [f](vector<T>& in, vector<int>&) {
+                for (T& item : in) f(item);
+            };
+            return op;
+        }, true);
+    }
+};
+
+// ----------- Example: parse -> enrich -> filter -> batch -> sink ------------
+
+struct Order {
+    int id = 0;
+    int userId = 0;
+    long cents = 0;
+    string tier;
+};
+
+static Order parseOrder(const string& line) {
+    Order order;
+    stringstream in(line);
+    char comma;
+    in >> order.id >> comma >> order.userId >> comma >> order.cents;
+    return order;
+}
+
+/**
+ * Main function - end-to-end pipeline, mixed execution, and backpressure
+ */
+int main() {
+    cout << "=== Stream Pipeline Demo ===" << endl;
+
+    const int totalOrders = 100000;
+    long expectedCents = 0;
+    int expectedCount = 0;
+    for (int i = 0; i < totalOrders; i++) {
+        long cents = (i * 37) % 10000;
+        if (cents >= 2500) {
+            expectedCents += cents;
+            expectedCount++;
+        }
+    }
+
+    cout << "\n--- parse (x2, pooled) -> enrich -> filter -> batch(100) -> sink ---" << endl;
+    {
+        Pipeline pipeline(1024, 2);
+        int next = 0;
+        long sinkCents = 0;
+        int sinkCount = 0, sinkBatches = 0;
+
+        pipeline
+            .source<string>("read", [&next, totalOrders](string& line) {
+                if (next == totalOrders) return false;
+                line = to_string(next) + "," + to_string(next % 500) + "," + to_string((next * 37L) % 10000);
+                next++;
+                return true;
+            })
+            .map("parse", parseOrder, StageOptions{2, Execution::Pooled, 64})
+            .map("enrich", [](Order& order) {
+                order.tier = order.userId < 50 ? "gold" : "standard";
+                return order;
+            })
+            .filter("filter", [](const Order& order) { return order.cents >= 2500; })
+            .batch("batch", 100)
+            .sink("sink", [&](vector<Order>& orders) {
+                sinkBatches++;
+                for (const Order& order : orders) {
+                    sinkCents += order.cents;
+                    sinkCount++;
+                }
+            });
+
+        pipeline.run();
+        cout << "Delivered " << sinkCount << " orders in " << sinkBatches << " batches: "
+             << (sinkCount == expectedCount && sinkCents == expectedCents ? "totals match" : "MISMATCH") << endl;
+        pipeline.printMetrics();
+    }
+
+    cout << "\n--- Backpressure: slow sink, channel capacity 64 ---" << endl;
+    {
+        Pipeline pipeline(64);
+        int next = 0, received = 0;
+        pipeline
+            .source<int>("fast", [&next](int& value) {
+                if (next == 2000) return false;
+                value = next++;
+                return true;
+            })
+            .sink("slow", [&received](int&) {
+                received++;
+                this_thread::sleep_for(chrono::microseconds(50));
+            });
+        pipeline.run();
+        cout << "Received " << received << " items; the source spent most of its time blocked:" << endl;
+        pipeline.printMetrics();
+    }
+
+    cout << "\n--- Pipeline Without a Sink ---" << endl;
+    {
+        Pipeline pipeline;
+        int next = 0;
+        pipeline
+            .source<int>("numbers", [&next](int& value) {
+                if (next == 10) return false;
+                value = next++;
+                return true;
+            })
+            .map("double", [](int& value) { return value * 2; });
+        bool ran = pipeline.run();
+        cout << "run(): " << (ran ? "ran" : "rejected") << endl;   // Should print rejected
+    }
+
+    return 0;
+}
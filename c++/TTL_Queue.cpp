@@ -0,0 +1,392 @@
+/*
+ * TTL Queue (per-element expiry)
+ *
+ * Some work is worthless after a deadline: a quote nobody will read, a retry
+ * for a request whose caller has already timed out. TtlQueue stores an expiry
+ * time with every element and makes sure consumers never receive a stale one:
+ *
+ * - pop() unlinks every expired element in front of the first live one under
+ *   a single lock acquisition, and frees that whole chain after unlocking
+ * - Elements with different TTLs may expire out of order; an expired element
+ *   in the middle is skipped when it reaches the front
+ * - A background sweeper reclaims memory for queues nobody is popping: once
+ *   the queue has been idle for `idleAfter`, it walks the list in bounded
+ *   slices (a cursor remembers where it stopped) and unlinks expired elements
+ *   anywhere in it. Busy queues are left to the lazy path. A lap records the
+ *   earliest expiry it kept, and the next lap waits for that time or for a
+ *   new push, so an idle queue of long-lived items is not rescanned forever.
+ *
+ * Operations to support:
+ * - push(x, ttl) / pushUntil(x, deadline)
+ * - tryPop(out): Oldest live element, false if there is none
+ * - pop(out, timeout): Same, waiting up to timeout for one to arrive
+ * - startSweeper(interval, idleAfter) / stopSweeper()
+ * - size(): Elements held, including expired ones not yet reclaimed
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+struct TtlStats {
+    uint64_t pushed = 0;
+    uint64_t popped = 0;            // Live elements handed to consumers
+    uint64_t expiredOnPop = 0;      // Dropped lazily by pop
+    uint64_t expiredBySweep = 0;    // Dropped by the background sweeper
+    uint64_t sweepPasses = 0;       // Slices the sweeper actually walked
+};
+
+// ----------- TTL Queue (LinkedList-based, thread safe) ------------
+template <typename T>
+class TtlQueue {
+private:
+    struct Node {
+        T val;
+        Clock::time_point expiresAt;
+        Node* next;
+        Node(const T& data, Clock::time_point deadline) : val(data), expiresAt(deadline), next(nullptr) {}
+    };
+
+    Node* frontNode = nullptr;
+    Node* rearNode = nullptr;
+    size_t count = 0;
+    TtlStats stats;
+    Clock::time_point lastPop = Clock::now();
+    Node* sweepCursor = nullptr;   // Last live node the sweeper kept; null = start at the front
+    // Nothing queued can expire before this, unless pushed since the last lap
+    Clock::time_point nextExpiry = Clock::time_point::min();
+    bool pushedSinceLap = false;
+
+    mutable mutex lock;
+    condition_variable notEmpty;
+
+    thread sweeper;
+    bool sweeperRunning = false;
+    condition_variable sweeperWake;
+
+    static void freeChain(Node* chain) {
+        while (chain != nullptr) {
+            Node* temp = chain;
+            chain = chain->next;
+            delete temp;
+        }
+    }
+
+    /**
+     * Unlinks the front node; the caller owns it afterwards. Lock must be held.
+     */
+    Node* unlinkFront() {
+        Node* temp = frontNode;
+        frontNode = frontNode->next;
+        if (frontNode == nullptr) rearNode = nullptr;
+        if (temp == sweepCursor) sweepCursor = nullptr;
+        count--;
+        return temp;
+    }
+
+    /**
+     * Unlinks expired nodes at the front onto `garbage`, then the first live node.
+     * Lock must be held.
+     * @return The live node, or null if none is queued
+     */
+    Node* popLiveLocked(Node*& garbage) {
+        if (frontNode == nullptr) return nullptr;
+        Clock::time_point now = Clock::now();
+        while (frontNode != nullptr && frontNode->expiresAt <= now) {
+            Node* expired = unlinkFront();
+            expired->next = garbage;
+            garbage = expired;
+            stats.expiredOnPop++;
+        }
+        if (frontNode == nullptr) return nullptr;
+        stats.popped++;
+        lastPop = now;
+        return unlinkFront();
+    }
+
+    /**
+     * Walks up to `budget` nodes from the sweep cursor, unlinking expired ones
+     * onto `garbage`. Lock must be held.
+     * @param removed Receives the number of nodes unlinked
+     * @param earliestKept Lowered to the expiry of every live node visited
+     * @return true if the walk reached the end of the list
+     */
+    bool sweepSlice(size_t budget, Clock::time_point now, Node*& garbage, size_t& removed,
+                    Clock::time_point& earliestKept) {
+        removed = 0;
+        Node* prev = sweepCursor;
+        Node* node = prev == nullptr ? frontNode : prev->next;
+        for (size_t visited = 0; node != nullptr && visited < budget; visited++) {
+            Node* next = node->next;
+            if (node->expiresAt <= now) {
+                if (prev == nullptr) frontNode = next;
+                else prev->next = next;
+                if (node == rearNode) rearNode = prev;
+                node->next = garbage;
+                garbage = node;
+                count--;
+                removed++;
+            } else {
+                if (node->expiresAt < earliestKept) earliestKept = node->expiresAt;
+                prev = node;
+            }
+            node = next;
+        }
+        // The cursor alone cannot tell whether the walk finished: it is also null
+        // when every node visited so far was expired and unlinked from the front
+        bool reachedEnd = node == nullptr;
+        sweepCursor = reachedEnd ? nullptr : prev;   // Wrap around at the end
+        return reachedEnd;
+    }
+
+    void sweepLoop(Clock::duration interval, Clock::duration idleAfter, size_t sliceNodes) {
+        unique_lock<mutex> guard(lock);
+        while (sweeperRunning) {
+            sweeperWake.wait_for(guard, interval, [&] { return !sweeperRunning; });
+            if (!sweeperRunning) break;
+            Clock::time_point now = Clock::now();
+            if (now - lastPop < idleAfter) continue;   // Consumers are active; pop reclaims
+            // The last lap left nothing that could have expired by now; pops only remove nodes
+            if (!pushedSinceLap && now < nextExpiry) continue;
+
+            // One lap from the cursor to the end, a slice per lock hold so producers are not stalled.
+            // A lap that starts mid-list has not seen the front, so it learns no bound.
+            bool fromFront = sweepCursor == nullptr;
+            pushedSinceLap = false;
+            Clock::time_point earliestKept = Clock::time_point::max();
+            bool reachedEnd = false;
+            while (sweeperRunning && !reachedEnd) {
+                Node* garbage = nullptr;
+                size_t removed = 0;
+                reachedEnd = sweepSlice(sliceNodes, now, garbage, removed, earliestKept);
+                stats.expiredBySweep += removed;
+                stats.sweepPasses++;
+                guard.unlock();
+                freeChain(garbage);
+                guard.lock();
+                now = Clock::now();
+            }
+            nextExpiry = reachedEnd && fromFront ? earliestKept : Clock::time_point::min();
+        }
+    }
+
+public:
+    TtlQueue() = default;
+    TtlQueue(const TtlQueue&) = delete;
+    TtlQueue& operator=(const TtlQueue&) = delete;
+
+    /**
+     * Adds an element that expires `ttl` from now
+     */
+    void push(const T& data, Clock::duration ttl) {
+        pushUntil(data, Clock::now() + ttl);
+    }
+
+    /**
+     * Adds an element that expires at `deadline`
+     */
+    void pushUntil(const T& data, Clock::time_point deadline) {
+        Node* newNode = new Node(data, deadline);
+        {
+            lock_guard<mutex> guard(lock);
+            if (rearNode == nullptr) {
+                frontNode = rearNode = newNode;
+            } else {
+                rearNode->next = newNode;
+                rearNode = newNode;
+            }
+            count++;
+            stats.pushed++;
+            pushedSinceLap = true;
+        }
+        notEmpty.notify_one();
+    }
+
+    /**
+     * Removes the oldest element that has not expired; expired ones ahead of it
+     * are unlinked in the same lock hold and freed after it
+     * @return false if no live element is queued
+     */
+    bool tryPop(T& out) {
+        Node* garbage = nullptr;
+        Node* live = nullptr;
+        {
+            lock_guard<mutex> guard(lock);
+            live = popLiveLocked(garbage);
+        }
+        freeChain(garbage);
+        if (live == nullptr) return false;
+        out = std::move(live->val);
+        delete live;
+        return true;
+    }
+
+    /**
+     * Like tryPop, but waits up to `timeout` for a live element
+     */
+    bool pop(T& out, Clock::duration timeout) {
+        Clock::time_point until = Clock::now() + timeout;
+        Node* garbage = nullptr;
+        Node* live = nullptr;
+        {
+            unique_lock<mutex> guard(lock);
+            while ((live = popLiveLocked(garbage)) == nullptr) {
+                if (notEmpty.wait_until(guard, until) == cv_status::timeout) {
+                    live = popLiveLocked(garbage);
+                    break;
+                }
+            }
+        }
+        freeChain(garbage);
+        if (live == nullptr) return false;
+        out = std::move(live->val);
+        delete live;
+        return true;
+    }
+
+    /**
+     * Starts the background sweeper
+     * @param interval How often it wakes up
+     * @param idleAfter Only sweeps when nothing was popped for this long
+     * @param sliceNodes Nodes visited per lock hold
+     */
+    void startSweeper(Clock::duration interval, Clock::duration idleAfter, size_t sliceNodes = 4096) {
+        lock_guard<mutex> guard(lock);
+        if (sweeperRunning) return;
+        sweeperRunning = true;
+        sweeper = thread([this, interval, idleAfter, sliceNodes] { sweepLoop(interval, idleAfter, sliceNodes); });
+    }
+
+    void stopSweeper() {
+        {
+            lock_guard<mutex> guard(lock);
+            sweeperRunning = false;
+        }
+        sweeperWake.notify_all();
+        if (sweeper.joinable()) sweeper.join();
+    }
+
+    size_t size() const {
+        lock_guard<mutex> guard(lock);
+        return count;
+    }
+
+    TtlStats getStats() const {
+        lock_guard<mutex> guard(lock);
+        return stats;
+    }
+
+    ~TtlQueue() {
+        stopSweeper();
+        freeChain(frontNode);
+    }
+
+};
+
+// ----------- Demo helpers ------------
+
+struct Quote {
+    int id;
+    Clock::time_point createdAt;
+};
+
+static double msSince(Clock::time_point t) {
+    return chrono::duration<double, milli>(Clock::now() - t).count();
+}
+
+/**
+ * Main function - lazy expiry, stale work avoided under overload, idle sweep
+ */
+int main() {
+    cout << "=== TTL Queue Demo ===" << endl;
+
+    cout << "\n--- Lazy Expiry ---" << endl;
+    {
+        TtlQueue<string> q;
+        q.push("quote A (20 ms)", chrono::milliseconds(20));
+        q.push("order B (1 s)", chrono::seconds(1));
+        q.push("quote C (20 ms)", chrono::milliseconds(20));
+        q.push("order D (1 s)", chrono::seconds(1));
+        this_thread::sleep_for(chrono::milliseconds(40));
+        string item;
+        while (q.tryPop(item)) cout << "Popped: " << item << endl;   // Should print B then D
+        TtlStats s = q.getStats();
+        cout << "Popped " << s.popped << ", expired on pop " << s.expiredOnPop << endl;   // 2, 2
+    }
+
+    cout << "\n--- Overloaded Consumer, 5 ms TTL ---" << endl;
+    {
+        // Producer offers bursts of 100 quotes every 5 ms (20k/s); each takes the consumer 100 us (10k/s)
+        TtlQueue<Quote> q;
+        const auto ttl = chrono::milliseconds(5);
+        atomic<bool> producing{true};
+        thread producer([&] {
+            for (int burst = 0; burst < 40; burst++) {
+                for (int i = 0; i < 100; i++) q.push(Quote{burst * 100 + i, Clock::now()}, ttl);
+                this_thread::sleep_for(chrono::milliseconds(5));
+            }
+            producing = false;
+        });
+        int handled = 0;
+        double oldestMs = 0;
+        Quote quote;
+        while (producing.load() || q.size() > 0) {
+            if (!q.pop(quote, chrono::milliseconds(10))) continue;
+            double age = msSince(quote.createdAt);
+            if (age > oldestMs) oldestMs = age;
+            auto busyUntil = Clock::now() + chrono::microseconds(100);
+            while (Clock::now() < busyUntil) {
+            }
+            handled++;
+        }
+        producer.join();
+        TtlStats s = q.getStats();
+        cout << "Handled " << handled << ", skipped as stale " << s.expiredOnPop << endl;
+        cout << "Oldest quote handled was " << oldestMs << " ms old (TTL 5 ms)" << endl;
+    }
+
+    cout << "\n--- Idle Queue, Everything Expired ---" << endl;
+    {
+        TtlQueue<int> q;
+        q.startSweeper(chrono::milliseconds(10), chrono::milliseconds(30));
+        for (int i = 0; i < 1000000; i++) q.push(i, chrono::milliseconds(20));
+        this_thread::sleep_for(chrono::milliseconds(300));
+        TtlStats s = q.getStats();
+        cout << "After 300 ms idle: " << q.size() << " held, swept " << s.expiredBySweep << " in "
+             << s.sweepPasses << " slices" << endl;   // 0 held
+    }
+
+    cout << "\n--- Idle Queue, Mixed TTLs ---" << endl;
+    {
+        TtlQueue<int> q;
+        q.startSweeper(chrono::milliseconds(10), chrono::milliseconds(30));
+        for (int i = 0; i < 1000000; i++) {
+            // Mixed TTLs: every 100th element lives for a minute
+            q.push(i, i % 100 == 0 ? chrono::duration_cast<Clock::duration>(chrono::minutes(1))
+                                   : chrono::duration_cast<Clock::duration>(chrono::milliseconds(20)));
+        }
+        cout << "Pushed: " << q.getStats().pushed << endl;   // Should print 1000000
+        this_thread::sleep_for(chrono::milliseconds(300));
+        TtlStats s = q.getStats();
+        cout << "After 300 ms idle: " << q.size() << " held, swept " << s.expiredBySweep << " in "
+             << s.sweepPasses << " slices" << endl;   // 10000 held
+        uint64_t slicesBefore = s.sweepPasses;
+        this_thread::sleep_for(chrono::milliseconds(200));
+        cout << "Slices walked in the next 200 ms: " << q.getStats().sweepPasses - slicesBefore
+             << endl;   // 0: the survivors live for a minute, so nothing is rescanned
+        int first = -1;
+        q.tryPop(first);
+        cout << "First live element: " << first << endl;   // Should print 0
+    }
+
+    return 0;
+}